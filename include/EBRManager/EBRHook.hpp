@@ -0,0 +1,45 @@
+// EBRHook.hpp
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief EBR 的侵入式退休钩子，作用与 Hazard 侧的 GCHook 相同。
+ *
+ * 节点类型继承它之后，EBRManager::retire 直接用节点自带的 ebr_next 把它串进
+ * 线程本地的退休链，不再为每次退休分配 GarbageNode。
+ * ebr_deleter 由 retire 填写，负责析构并释放整个节点。
+ *
+ * ebr_birth_era / ebr_retire_era 供 EBRManager 的健壮模式（区间回收）使用：
+ * 容器分配节点后用 ebr::stampBirth 记录出生纪年，retire 时记录退休纪年。
+ */
+struct EBRHook {
+    EBRHook* ebr_next = nullptr;
+    void (*ebr_deleter)(EBRHook*) = nullptr;
+    uint64_t ebr_birth_era  = 0;
+    uint64_t ebr_retire_era = 0;
+
+    // 释放以 head 开头的整条钩子链；签名与 GarbageNode 的 deleter 一致
+    static void reclaimChain(void* head) noexcept;
+    // 链上的节点个数
+    static size_t chainLength(const void* head) noexcept;
+};
+
+inline void EBRHook::reclaimChain(void* head) noexcept {
+    EBRHook* current = static_cast<EBRHook*>(head);
+    while (current != nullptr) {
+        EBRHook* next = current->ebr_next; // 先保存，deleter 会释放当前节点
+        current->ebr_deleter(current);
+        current = next;
+    }
+}
+
+inline size_t EBRHook::chainLength(const void* head) noexcept {
+    size_t length = 0;
+    for (const EBRHook* current = static_cast<const EBRHook*>(head);
+         current != nullptr; current = current->ebr_next) {
+        ++length;
+    }
+    return length;
+}
@@ -2,14 +2,32 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <type_traits>
+#include "EBRManager/EBRHook.hpp"
 #include "EBRManager/ThreadSlotManager.hpp"
 #include "EBRManager/GarbageCollector.hpp"
 #include "EBRManager/GarbageNode.hpp"
+#include "EBRManager/RetireBag.hpp"
 #include "EBRManager/LockFreeSingleLinkedList.hpp"
+#include "Tool/RetireBudget.hpp"
+#include "Tool/ShmMutexLock.hpp"
 #include "gc_malloc/ThreadHeap/ThreadHeap.hpp"
 
 class EBRManager {
+public:
+    // 纪元推进的诊断快照
+    struct Stats {
+        uint64_t global_epoch;
+        uint64_t stalled_ns;          // 距上一次成功推进纪元的时间
+        int64_t  blocking_slot;       // 最近一次推进失败时挡住纪元的槽位序号，-1 表示没有
+        uint64_t blocking_slot_epoch; // 该槽位停留的纪元
+        uint64_t pending_garbage;     // 已退休、尚未释放的对象数（近似值）
+        uint64_t robust_reclaimed;    // 健壮模式下绕过纪元规则释放的对象数
+        uint64_t retired_bytes;       // 已退休、尚未释放的字节数（按 sizeof(T) 计量）
+    };
+
 public:
     EBRManager();
     ~EBRManager();
@@ -25,20 +43,116 @@ public:
     template<typename T>
     void retire(T* ptr);
 
+    // --- 后台回收 ---
+    // 开启后 leave 只修改本线程槽位，纪元推进与析构全部交给调用 reclaimStep 的线程（见 EBRReclaimer）。
+    // 关闭时把尚未处理完的待回收批次就地释放。
+    void setBackgroundReclaim(bool enabled);
+    bool isBackgroundReclaim() const noexcept;
+    // 推进一次纪元并释放至多 max_nodes 个 GarbageNode，返回释放的对象数；可由多个线程并发调用
+    size_t reclaimStep(size_t max_nodes);
+
+    // --- 诊断 ---
+    Stats getStats() const;
+
+    // --- 退休内存预算 ---
+    // 未释放的对象数或字节数超过上限（0 表示不限）时，retire 就地推进纪元并回收一轮
+    // （后台模式下代为执行一次 reclaimStep）；max_backpressure 非 0 时仍超出预算的 retire
+    // 反复回收、至多等待这么久。retire 通常在临界区内调用，本线程自己也钉住了纪元，
+    // 所以背压只能等其他线程离开，必须有时限；读者停滞时由 getBudgetOverrunCount 反映。
+    void setRetireBudget(size_t max_nodes, size_t max_bytes,
+                         std::chrono::nanoseconds max_backpressure = std::chrono::nanoseconds::zero()) noexcept;
+    size_t getRetiredBytes() const noexcept;
+    uint64_t getBudgetOverrunCount() const noexcept;
+
+    // --- 健壮模式（区间回收） ---
+    // 纪元被停滞的读者卡住超过 stall_threshold 后，按节点的 [出生纪年, 退休纪年]
+    // 与各活跃线程保留的纪年区间是否相交来释放继承了 EBRHook 的节点，使未回收内存有界。
+    // 要求容器用 stampBirth 标记新节点、用 protectedLoad 读取会被解引用的指针；
+    // 必须在管理器被并发使用之前设置。
+    void setRobustMode(bool enabled,
+                       std::chrono::nanoseconds stall_threshold = std::chrono::milliseconds(10));
+    bool isRobustMode() const noexcept;
+    // 记录节点的出生纪年（节点发布之前调用）
+    void stampBirth(EBRHook* node) noexcept;
+    // 读取一个会被解引用的原子指针；健壮模式下把读到的纪年并入本线程的保留区间
+    template<typename Atomic>
+    auto protectedLoad(const Atomic& location) -> decltype(location.load());
+
 public:
     static constexpr size_t kNumEpochLists = 3;
+    // 本线程和全局都没有待回收垃圾时，每隔这么多次 leave 才扫描一次槽位
+    static constexpr uint64_t kAdvanceInterval = 64;
+    // 每个线程每退休这么多个对象推进一次纪年
+    static constexpr uint64_t kEraInterval = 64;
+    // 健壮模式下，待回收对象比上次扫描后每增长这么多才再扫描一次
+    static constexpr uint64_t kRobustScanInterval = 256;
+    // 后台模式下超出预算的 retire 代为执行 reclaimStep 时每次释放的 GarbageNode 上限
+    static constexpr size_t kBudgetHelpStep = 64;
+    static_assert(kNumEpochLists == ThreadSlot::kNumRetireBags,
+                  "each epoch list needs a matching per-thread retire bag");
 
-private:
+protected:
+    // 以下实现细节对 QSBRManager 开放：两者共用槽位、limbo bag、全局链表与纪元推进规则
     bool tryAdvanceEpoch_();
+    // 线程离开临界区（或到达静止点）之后：按摊销规则推进纪元并回收
+    void tryReclaim_(ThreadSlot* slot);
+    bool hasGlobalGarbage_() const noexcept;
     void collectGarbage_(uint64_t epoch_to_collect);
+    // 摘下纪元 epoch_to_collect 的全局链表；纪元已经不是 epoch_to_collect + 2 时放回并返回 nullptr
+    GarbageNode* stealCollectable_(uint64_t epoch_to_collect);
     ThreadSlot* getLocalSlot_();
 
-private:
+    // 非模板的退休路径：放进本线程的 limbo bag
+    void retireRaw_(void* ptr, void (*deleter)(void*));
+    // 侵入式退休路径：节点自带钩子，直接串进 bag 的钩子链，不分配内存
+    void retireHooked_(EBRHook* node);
+    // 单个指针直接挂到全局链表（没有槽位或内存不足时的后备路径）
+    void pushGlobal_(size_t index, void* ptr, void (*deleter)(void*));
+    // 把 bag 转成 GarbageNode 链一次挂到全局链表；内存不足、没能清空时返回 false
+    bool flushRetireBag_(ThreadSlot* slot, size_t index);
+    // 直接释放本线程中纪元已足够旧的 bag
+    void reclaimLocalBags_(ThreadSlot* slot, uint64_t global_epoch);
+    // 同一下标上的旧 bag 被复用前清空：后台模式下转交全局链表，否则就地释放
+    void recycleStaleBag_(ThreadSlot* slot, size_t index);
+    // 线程退出时把槽位上未回收的 bag 全部交给全局链表
+    static void onSlotReleased_(void* self, ThreadSlot* slot);
+
+    // 计入退休预算，超出时帮忙回收或等待
+    void chargeRetired_(size_t bytes);
+    // 每次退休都要计数，并按 kEraInterval 推进纪年；返回节点的退休纪年
+    uint64_t noteRetired_(ThreadSlot* slot);
+    void noteReclaimed_(size_t count) noexcept;
+    uint64_t pendingGarbage_() const;
+    static uint64_t nowNs_() noexcept;
+    // 距上次推进纪元已超过健壮模式的停滞阈值
+    bool isStalled_() const noexcept;
+    // 纪元停滞时的区间回收：只处理钩子链，普通指针仍等纪元推进
+    void robustScan_(ThreadSlot* slot);
+
+protected:
     alignas(64) std::atomic<uint64_t> global_epoch_;
     LockFreeSingleLinkedList garbage_lists_[kNumEpochLists];
 
     ThreadSlotManager slot_manager_;
     GarbageCollector garbage_collector_;
+
+    std::atomic<bool> background_reclaim_;
+
+    // 诊断计数
+    std::atomic<uint64_t> last_advance_ns_;
+    std::atomic<int64_t>  blocking_slot_;
+    std::atomic<uint64_t> blocking_slot_epoch_;
+    std::atomic<uint64_t> orphan_retired_;   // 没有槽位时的退休数
+    std::atomic<uint64_t> reclaimed_count_;
+    RetireBudget          budget_;
+
+    // 健壮模式
+    alignas(64) std::atomic<uint64_t> era_clock_;
+    std::atomic<bool>     robust_mode_;
+    std::atomic<int64_t>  stall_threshold_ns_;
+    std::atomic<uint64_t> robust_scan_mark_;
+    std::atomic<uint64_t> robust_reclaimed_;
+    ShmMutexLock          robust_lock_;
 };
 
 
@@ -48,15 +162,37 @@ void EBRManager::retire(T* ptr) {
         return;
     }
     
-    auto deleter = [](void* p) {
-        T* typed_p   = static_cast<T*>(p);
-        typed_p->~T();
-        ThreadHeap::deallocate(typed_p);
-    };
+    if constexpr (std::is_base_of<EBRHook, T>::value) {
+        ptr->ebr_deleter = [](EBRHook* h) {
+            T* typed_p   = static_cast<T*>(h);
+            typed_p->~T();
+            ThreadHeap::deallocate(typed_p);
+        };
+        retireHooked_(ptr);
+        chargeRetired_(sizeof(T));
+    } else {
+        auto deleter = [](void* p) {
+            T* typed_p   = static_cast<T*>(p);
+            typed_p->~T();
+            ThreadHeap::deallocate(typed_p);
+        };
 
-    void* gnode_mem = ThreadHeap::allocate(sizeof(GarbageNode));
-    GarbageNode* g_node = new(gnode_mem) GarbageNode(ptr, deleter);
+        retireRaw_(ptr, deleter);
+        chargeRetired_(sizeof(T));
+    }
+}
 
-    uint64_t current_epoch = global_epoch_.load(std::memory_order_relaxed);
-    this->garbage_lists_[current_epoch % kNumEpochLists].pushNode(g_node);
+template<typename Atomic>
+auto EBRManager::protectedLoad(const Atomic& location) -> decltype(location.load()) {
+    if (!robust_mode_.load(std::memory_order_relaxed)) {
+        return location.load(std::memory_order_acquire);
+    }
+    ThreadSlot* slot = getLocalSlot_();
+    for (;;) {
+        auto value = location.load(std::memory_order_acquire);
+        // 读到值之后纪年没有超出保留区间，说明被指向的节点出生在区间之内
+        if (!slot || slot->extendReservation(era_clock_.load(std::memory_order_seq_cst))) {
+            return value;
+        }
+    }
 }
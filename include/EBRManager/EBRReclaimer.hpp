@@ -0,0 +1,60 @@
+// EBRReclaimer.hpp
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "EBRManager/EBRManager.hpp"
+
+/**
+ * @class EBRReclaimer
+ * @brief EBRManager 的后台回收线程（池）。
+ *
+ * 构造时把管理器切到后台回收模式并启动 num_threads 个线程；此后业务线程的
+ * enter/leave 只修改自己的槽位，推进纪元与析构垃圾都由这里的线程完成，
+ * 每一步至多释放 batch_size 个 GarbageNode，空闲时休眠 idle_interval。
+ *
+ * 析构（或 stop）时停止线程并把管理器切回就地回收模式。
+ * 必须先于所服务的 EBRManager 析构。
+ */
+class EBRReclaimer {
+public:
+    static constexpr size_t kDefaultBatchSize = 256;
+
+    explicit EBRReclaimer(EBRManager& manager,
+                          size_t num_threads = 1,
+                          size_t batch_size = kDefaultBatchSize,
+                          std::chrono::microseconds idle_interval = std::chrono::microseconds(200));
+    ~EBRReclaimer();
+
+    EBRReclaimer(const EBRReclaimer&) = delete;
+    EBRReclaimer& operator=(const EBRReclaimer&) = delete;
+    EBRReclaimer(EBRReclaimer&&) = delete;
+    EBRReclaimer& operator=(EBRReclaimer&&) = delete;
+
+    // 停止并回收全部线程；可重复调用
+    void stop();
+
+    // 累计释放的 GarbageNode 数量
+    uint64_t getReclaimedCount() const noexcept;
+
+private:
+    void run_();
+
+private:
+    EBRManager& manager_;
+    const size_t batch_size_;
+    const std::chrono::microseconds idle_interval_;
+
+    std::atomic<uint64_t> reclaimed_count_;
+    bool stopping_;
+    std::mutex wait_mutex_;
+    std::condition_variable wait_cv_;
+    std::vector<std::thread> threads_;
+};
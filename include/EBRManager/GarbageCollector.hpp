@@ -1,50 +1,181 @@
 #pragma once
 
-#include <mutex>
+#include <atomic>
+#include <cstddef>
 
-#include "Tool/ShmMutexLock.hpp"
 #include "EBRManager/GarbageNode.hpp"
+#include "EBRManager/EBRHook.hpp"
 #include "gc_malloc/ThreadHeap/ThreadHeap.hpp"
 
 /**
  * @class GarbageCollector
- * @brief 负责安全地回收和释放由 LockFreeSingleLinkedList 提供的垃圾节点链表。
+ * @brief 负责释放由 LockFreeSingleLinkedList 摘下的垃圾节点链表，可由多个线程分块并行处理。
  *
- * 该类提供了一个线程安全的 `collect` 方法，它接收一个垃圾链表的头节点，
- * 然后在互斥锁的保护下，遍历整个链表，为每个节点调用析构函数并使用
- * ThreadHeap 释放其内存。
+ * 长链按 kChunkSize 个节点切块：释放一块之前先把剩余部分发布到回收器内的块槽位，
+ * 任何线程都可以调用 `help` 取走一段，释放其链头的一块后再把剩余部分重新发布。
+ * `collect` 在返回前会一直帮忙，直到槽位清空，与此同时其他线程也能分担；
+ * `defer` 只发布不释放，配合 `help(max_nodes)` 把一次大批量删除拆成多次有界的小步。
+ * 各个线程互不阻塞，不需要全局互斥锁。
+ *
+ * 块槽位全部被占用时，调用线程自己继续往下释放，保证不会丢失垃圾。
+ * 析构（或 `drain`）时释放所有仍在槽位中的垃圾。
  */
 class GarbageCollector {
 public:
     using Node = GarbageNode;
 
-    GarbageCollector() = default;
+    // 每一步就地释放的 GarbageNode 数
+    static constexpr size_t kChunkSize = 64;
+    // 同时等待处理的块的上限
+    static constexpr size_t kMaxChunks = 32;
+
+    GarbageCollector() noexcept;
 
-    ~GarbageCollector() = default;
+    // 调用时不应再有其他线程使用回收器
+    ~GarbageCollector();
 
     GarbageCollector(const GarbageCollector&) = delete;
     GarbageCollector& operator=(const GarbageCollector&) = delete;
     GarbageCollector(GarbageCollector&&) = delete;
     GarbageCollector& operator=(GarbageCollector&&) = delete;
 
-    void collect(Node* garbage_list_head);
+    // 释放整条链表（其他线程可以通过 help 并行分担），返回本线程释放的对象数（一条 EBRHook 链按链长计）
+    size_t collect(Node* garbage_list_head);
+    // 整条链都交给 help，本线程不做析构；槽位已满时退化为 collect
+    size_t defer(Node* garbage_list_head);
+    // 取走一段已发布的垃圾，释放其中至多 max_nodes 个节点；没有待处理的垃圾时返回 0
+    size_t help(size_t max_nodes = kChunkSize);
+    // 释放所有已发布的垃圾（可与其他线程的 help 并发）
+    size_t drain();
+    // 是否有已发布、尚未被取走的垃圾
+    bool hasPending() const noexcept;
+
+    // 保留链头的至多 max_nodes 个节点，返回截下的剩余部分；max_nodes 为 0 表示不截断
+    static Node* splitBatch(Node* garbage_list_head, size_t max_nodes) noexcept;
 
 private:
-    mutable ShmMutexLock lock_;
+    // 把 rest 放进空闲槽位；槽位已满时返回 false
+    bool publish_(Node* rest) noexcept;
+    Node* take_() noexcept;
+    // 释放 head 的一块，剩余部分发布出去（发布失败则继续释放），返回释放的对象数
+    size_t collectChunked_(Node* head, size_t max_nodes);
+    // 逐个析构并释放整条链
+    static size_t collectChain_(Node* head) noexcept;
+
+    std::atomic<size_t> pending_chunks_;
+    std::atomic<Node*>  chunks_[kMaxChunks];
 };
 
 
-inline void GarbageCollector::collect(Node* garbage_list_head) {
-    // 如果传入的是空链表，直接返回，无需加锁。
-    if (!garbage_list_head) {
-        return;
+inline GarbageCollector::GarbageCollector() noexcept : pending_chunks_(0) {
+    for (auto& chunk : chunks_) {
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+inline GarbageCollector::~GarbageCollector() {
+    drain();
+}
+
+inline size_t GarbageCollector::collect(Node* garbage_list_head) {
+    size_t collected = collectChunked_(garbage_list_head, kChunkSize);
+    // 继续处理已发布的块，直到被其他线程取空
+    while (hasPending()) {
+        Node* head = take_();
+        if (!head) {
+            break;
+        }
+        collected += collectChunked_(head, kChunkSize);
+    }
+    return collected;
+}
+
+inline size_t GarbageCollector::defer(Node* garbage_list_head) {
+    if (!garbage_list_head || publish_(garbage_list_head)) {
+        return 0;
+    }
+    return collect(garbage_list_head);
+}
+
+inline size_t GarbageCollector::help(size_t max_nodes) {
+    if (!hasPending()) {
+        return 0;
     }
+    return collectChunked_(take_(), max_nodes);
+}
 
-    std::lock_guard<ShmMutexLock> lock(lock_);
+inline size_t GarbageCollector::drain() {
+    size_t collected = 0;
+    while (hasPending()) {
+        Node* head = take_();
+        if (!head) {
+            break; // 剩下的都已被其他线程取走
+        }
+        collected += collectChain_(head);
+    }
+    return collected;
+}
 
-    Node* current = garbage_list_head;
+inline bool GarbageCollector::hasPending() const noexcept {
+    return pending_chunks_.load(std::memory_order_acquire) != 0;
+}
+
+inline bool GarbageCollector::publish_(Node* rest) noexcept {
+    for (auto& chunk : chunks_) {
+        Node* expected = nullptr;
+        if (chunk.load(std::memory_order_relaxed) == nullptr &&
+            chunk.compare_exchange_strong(expected, rest,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed)) {
+            pending_chunks_.fetch_add(1, std::memory_order_release);
+            return true;
+        }
+    }
+    return false;
+}
+
+inline GarbageCollector::Node* GarbageCollector::take_() noexcept {
+    for (auto& chunk : chunks_) {
+        // exchange 独占整段，不存在 ABA：槽位里的链在被取走之前不会被任何人修改
+        if (chunk.load(std::memory_order_relaxed) != nullptr) {
+            Node* head = chunk.exchange(nullptr, std::memory_order_acquire);
+            if (head) {
+                pending_chunks_.fetch_sub(1, std::memory_order_relaxed);
+                return head;
+            }
+        }
+    }
+    return nullptr;
+}
+
+inline size_t GarbageCollector::collectChunked_(Node* head, size_t max_nodes) {
+    size_t collected = 0;
+    while (head) {
+        Node* rest = splitBatch(head, max_nodes);
+        // 先发布剩余部分，其他线程可以与本线程并行释放
+        if (rest && publish_(rest)) {
+            rest = nullptr;
+        }
+        collected += collectChain_(head);
+        head = rest;
+    }
+    return collected;
+}
+
+inline size_t GarbageCollector::collectChain_(Node* head) noexcept {
+    size_t collected = 0;
+    Node* current = head;
     while (current != nullptr) {
         Node* next = current->next; // 提前保存下一个节点
+#if defined(__GNUC__) || defined(__clang__)
+        // 下一个节点的缓存缺失与本节点的析构重叠
+        if (next) {
+            __builtin_prefetch(next);
+        }
+#endif
+        collected += (current->deleter == &EBRHook::reclaimChain)
+                         ? EBRHook::chainLength(current->garbage_ptr)
+                         : 1;
 
         // 步骤 1: 显式调用析构函数，清理对象状态
         current->~Node();
@@ -54,4 +185,20 @@ inline void GarbageCollector::collect(Node* garbage_list_head) {
 
         current = next; // 移动到下一个节点
     }
-}
\ No newline at end of file
+    return collected;
+}
+
+inline GarbageCollector::Node* GarbageCollector::splitBatch(Node* garbage_list_head,
+                                                            size_t max_nodes) noexcept {
+    if (!garbage_list_head || max_nodes == 0) {
+        return nullptr;
+    }
+
+    Node* last = garbage_list_head;
+    for (size_t i = 1; i < max_nodes && last->next != nullptr; ++i) {
+        last = last->next;
+    }
+    Node* rest = last->next;
+    last->next = nullptr;
+    return rest;
+}
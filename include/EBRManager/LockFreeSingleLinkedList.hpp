@@ -22,5 +22,9 @@ public:
     LockFreeSingleLinkedList& operator=(LockFreeSingleLinkedList&&) = delete;
 
     void pushNode(Node* new_node);
+    // 把 first -> ... -> last 这一段已经串好的链一次 CAS 挂上去
+    void pushChain(Node* first, Node* last);
     Node* stealList() noexcept;
+    // 只读快照，用于判断是否值得尝试回收
+    bool isEmpty() const noexcept;
 };
@@ -0,0 +1,51 @@
+// EBRManager/QSBRManager.hpp
+#pragma once
+
+#include "EBRManager/EBRManager.hpp"
+
+/**
+ * @class QSBRManager
+ * @brief 基于静止状态的回收（QSBR），与 EBRManager 提供相同的 retire 接口。
+ *
+ * 线程在事件循环等天然的边界上调用 quiescent()，声明此刻不持有任何共享节点的引用；
+ * 读侧的 enter/leave 不写共享内存（enter 只在线程尚未上线时登记一次，leave 为空操作）。
+ * 纪元只有在所有在线线程都观察到当前纪元后才能推进，纪元 e 退休的对象在
+ * 全局纪元到达 e + 2 后释放——与 EBRManager 相同，因此复用其槽位、limbo bag 与全局链表。
+ *
+ * 长时间阻塞或不再访问容器的线程应调用 offline()，否则会阻止所有回收；
+ * 线程退出时自动下线。
+ *
+ * 可作为 LockFreeHashMap / LockFreeChain / LockFreeSkipList 的 Reclaimer 模板参数。
+ */
+class QSBRManager : protected EBRManager {
+public:
+    QSBRManager() = default;
+    ~QSBRManager() = default;
+
+    QSBRManager(const QSBRManager&) = delete;
+    QSBRManager& operator=(const QSBRManager&) = delete;
+    QSBRManager(QSBRManager&&) = delete;
+    QSBRManager& operator=(QSBRManager&&) = delete;
+
+    // --- 读侧（与 EBRManager 同名，供 ebr::Guard 使用） ---
+    void enter();
+    void leave() noexcept {}
+
+    // --- 静止状态 ---
+    // 声明本线程不再持有引用，并在需要时推进纪元、回收垃圾
+    void quiescent();
+    // 进入 / 退出扩展静止状态：离线期间不参与纪元推进的判定
+    void online();
+    void offline();
+
+    using EBRManager::retire;
+    using EBRManager::kNumEpochLists;
+    // 诊断接口与容器钩子；QSBR 不提供健壮模式，protectedLoad 总是普通的 acquire 读
+    using EBRManager::Stats;
+    using EBRManager::getStats;
+    using EBRManager::setRetireBudget;
+    using EBRManager::getRetiredBytes;
+    using EBRManager::getBudgetOverrunCount;
+    using EBRManager::stampBirth;
+    using EBRManager::protectedLoad;
+};
@@ -0,0 +1,67 @@
+// RetireBag.hpp
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "EBRManager/EBRHook.hpp"
+
+/**
+ * @class RetireBag
+ * @brief 线程本地的“limbo bag”：批量暂存同一纪元内退休的指针。
+ *
+ * 每个 ThreadSlot 内嵌三个 bag（按 epoch % 3 索引），retire 只是往本线程的 bag 里追加一项，
+ * 既不分配 GarbageNode，也不碰全局链表。
+ * 纪元推进到 bag 纪元 + 2 之后，由持有者线程直接释放；
+ * 只有纪元迟迟不能推进、bag 装满（或线程退出）时，才把内容转成 GarbageNode 链一次性挂到全局链表。
+ *
+ * 继承了 EBRHook 的节点不占数组项，而是用自身的 ebr_next 串成一条侵入式链，
+ * 挂到全局链表时整条链只需要一个 GarbageNode。
+ *
+ * bag 只被所属 ThreadSlot 的当前持有者线程访问，内部不做同步。
+ */
+class RetireBag {
+public:
+    static constexpr std::size_t kCapacity = 64;
+
+    struct Entry {
+        void* ptr;
+        void (*deleter)(void*);
+    };
+
+    RetireBag() noexcept;
+    ~RetireBag();
+
+    RetireBag(const RetireBag&) = delete;
+    RetireBag& operator=(const RetireBag&) = delete;
+    RetireBag(RetireBag&&) = delete;
+    RetireBag& operator=(RetireBag&&) = delete;
+
+    // 追加一项；bag 为空时记录纪元。调用方保证 bag 未满。
+    void push(uint64_t epoch, void* ptr, void (*deleter)(void*)) noexcept;
+    // 把自带钩子的节点串到侵入式链上（不占数组项，没有容量限制）
+    void pushHooked(uint64_t epoch, EBRHook* node) noexcept;
+    // 摘下整条侵入式链（以 ebr_next 串联），链为空时返回 nullptr
+    EBRHook* takeHookedChain() noexcept;
+
+    // 取出最后一项；bag 为空时返回 false
+    bool popBack(Entry& out) noexcept;
+
+    // 调用全部 deleter 并清空 bag，返回释放的数量
+    std::size_t reclaimAll() noexcept;
+
+    bool isEmpty() const noexcept { return count_ == 0 && hooked_head_ == nullptr; }
+    bool isFull() const noexcept { return count_ == kCapacity; }
+    // 侵入式链长度达到 kCapacity 时也应当转交全局链表，避免纪元卡住时无限增长
+    bool isHookedChainFull() const noexcept { return hooked_count_ >= kCapacity; }
+    std::size_t size() const noexcept { return count_ + hooked_count_; }
+    uint64_t getEpoch() const noexcept { return epoch_; }
+
+private:
+    uint64_t    epoch_;
+    std::size_t count_;
+    Entry       entries_[kCapacity];
+
+    EBRHook*    hooked_head_;
+    std::size_t hooked_count_;
+};
@@ -0,0 +1,69 @@
+// EBRManager/ShmEBRDomain.hpp
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <sys/types.h>
+
+#include "Tool/PidSlotTable.hpp"
+
+/**
+ * @class ShmEBRDomain
+ * @brief 放在共享内存中的 EBR 域：全局纪元 + 固定大小的槽位表。
+ *
+ * 多个进程（及其线程）各自占用一个槽位，槽位登记持有者的 PID。
+ * 对象不含任何进程相关的指针，可以直接 placement new 到 ShmSegment / ThreadHeap 内存中。
+ *
+ * 纪元推进时如果某个活跃槽位的纪元落后，会检查持有进程是否还活着（见 PidSlotTable）；
+ * 已经崩溃的进程的槽位会被直接回收，不会永久阻塞纪元推进。
+ *
+ * 垃圾链表、deleter 等进程相关的状态放在每个进程自己的 ShmEBRManager 中。
+ */
+class ShmEBRDomain {
+public:
+    static constexpr size_t kMaxSlots = 128;
+    static constexpr int32_t kInvalidSlot = -1;
+
+    ShmEBRDomain() noexcept;
+    ~ShmEBRDomain() = default;
+
+    ShmEBRDomain(const ShmEBRDomain&) = delete;
+    ShmEBRDomain& operator=(const ShmEBRDomain&) = delete;
+    ShmEBRDomain(ShmEBRDomain&&) = delete;
+    ShmEBRDomain& operator=(ShmEBRDomain&&) = delete;
+
+    // --- 槽位登记 ---
+    // 为 pid 占用一个空闲槽位；没有空槽时先回收已死进程的槽位，仍然没有则返回 kInvalidSlot
+    int32_t acquireSlot(pid_t pid) noexcept;
+    void releaseSlot(int32_t index) noexcept;
+
+    // --- 临界区（只允许槽位持有者调用，不计嵌套） ---
+    void enter(int32_t index) noexcept;
+    void leave(int32_t index) noexcept;
+
+    // --- 纪元 ---
+    uint64_t getEpoch() const noexcept;
+    // 所有活跃槽位都已观察到当前纪元时把纪元加一；顺带回收挡路的死进程槽位
+    bool tryAdvanceEpoch() noexcept;
+
+    // 回收所有持有者已经退出的槽位，返回回收的数量
+    size_t reapDeadSlots() noexcept;
+
+    pid_t getSlotOwner(int32_t index) const noexcept;
+    size_t getUsedSlotCount() const noexcept;
+
+private:
+    // 槽位状态布局与 ThreadSlot 相同：epoch << 1 | active
+    static constexpr uint64_t kActiveBit = 1ULL;
+
+    using SlotTable = PidSlotTable<std::atomic<uint64_t>, kMaxSlots>;
+
+    // 回收死进程槽位时清空它的状态
+    static void clearState_(std::atomic<uint64_t>& state) noexcept {
+        state.store(0, std::memory_order_relaxed);
+    }
+
+    alignas(64) std::atomic<uint64_t> global_epoch_;
+    SlotTable slots_;
+};
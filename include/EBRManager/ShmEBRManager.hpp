@@ -0,0 +1,102 @@
+// EBRManager/ShmEBRManager.hpp
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "EBRManager/ShmEBRDomain.hpp"
+#include "EBRManager/EBRHook.hpp"
+#include "EBRManager/GarbageCollector.hpp"
+#include "EBRManager/GarbageNode.hpp"
+#include "EBRManager/LockFreeSingleLinkedList.hpp"
+#include "gc_malloc/ThreadHeap/ThreadHeap.hpp"
+
+/**
+ * @class ShmEBRManager
+ * @brief 挂接到共享内存 ShmEBRDomain 上的进程本地 EBR 管理器，接口与 EBRManager 相同。
+ *
+ * 每个进程（fork 之后）各自构造一个实例：线程第一次 enter 时在域里占用一个槽位，
+ * 线程退出或管理器析构时归还。纪元由所有进程共享，因此一个进程退休的节点
+ * 只有在所有进程的读者都离开之后才会释放。
+ *
+ * deleter 是进程内的函数指针，所以垃圾链表留在本进程；
+ * 进程崩溃时它的垃圾会泄漏，但它占用的槽位会被其他进程回收，不会阻塞纪元推进。
+ *
+ * 可作为 LockFreeSkipList 等容器的 Reclaimer 模板参数（容器需要在每个进程里引用本进程的实例）。
+ */
+class ShmEBRManager {
+public:
+    static constexpr size_t kNumEpochLists = 3;
+    // 本进程没有待回收垃圾时，每隔这么多次 leave 才尝试推进一次纪元
+    static constexpr uint64_t kAdvanceInterval = 64;
+
+    explicit ShmEBRManager(ShmEBRDomain& domain);
+    // 归还本实例占用的全部槽位，并在纪元允许的范围内释放垃圾；
+    // 仍可能被其他进程引用的垃圾宁可泄漏也不提前释放
+    ~ShmEBRManager();
+
+    ShmEBRManager(const ShmEBRManager&) = delete;
+    ShmEBRManager& operator=(const ShmEBRManager&) = delete;
+    ShmEBRManager(ShmEBRManager&&) = delete;
+    ShmEBRManager& operator=(ShmEBRManager&&) = delete;
+
+    // 可嵌套，只有最外层修改域中的槽位
+    void enter();
+    void leave();
+
+    template<typename T>
+    void retire(T* ptr);
+
+    // 与 EBRManager 的容器接口对齐；本管理器没有健壮模式，两者都是普通操作
+    void stampBirth(EBRHook*) noexcept {}
+    template<typename Atomic>
+    auto protectedLoad(const Atomic& location) -> decltype(location.load()) {
+        return location.load(std::memory_order_acquire);
+    }
+
+    ShmEBRDomain& getDomain() noexcept { return domain_; }
+
+private:
+    // 线程在本实例上的本地状态
+    struct LocalState {
+        int32_t  slot_index;
+        uint32_t nest_depth;
+        uint64_t leave_count;
+    };
+
+    LocalState* getLocalState_();
+    void releaseSlot_(int32_t slot_index) noexcept;
+
+    void retireRaw_(void* ptr, void (*deleter)(void*));
+    bool hasGarbage_() const noexcept;
+    // 全局纪元为 global_epoch 时回收纪元 global_epoch - 2 的链表（每个纪元只回收一次）
+    void collect_(uint64_t global_epoch);
+
+private:
+    ShmEBRDomain& domain_;
+    const uint64_t instance_id_;
+
+    LockFreeSingleLinkedList garbage_lists_[kNumEpochLists];
+    GarbageCollector garbage_collector_;
+    std::atomic<uint64_t> last_collected_epoch_;
+
+    // 本实例在域中占用的槽位，析构时统一归还
+    std::atomic<bool> owned_slots_[ShmEBRDomain::kMaxSlots];
+};
+
+
+template<typename T>
+void ShmEBRManager::retire(T* ptr) {
+    if (ptr == nullptr) {
+        return;
+    }
+
+    auto deleter = [](void* p) {
+        T* typed_p = static_cast<T*>(p);
+        typed_p->~T();
+        ThreadHeap::deallocate(typed_p);
+    };
+
+    retireRaw_(ptr, deleter);
+}
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 
+#include "EBRManager/RetireBag.hpp"
+
 /**
  * @brief 代表一个线程在EBR管理器中的专属槽位。
  *
@@ -10,6 +13,8 @@
  */
 class ThreadSlot {
 public:
+    static constexpr size_t kNumRetireBags = 3;
+
     // --- 侵入式设计所需 ---
     ThreadSlot* next;
 
@@ -23,20 +28,49 @@ public:
     ThreadSlot(ThreadSlot&&) = delete;
     ThreadSlot& operator=(ThreadSlot&&) = delete;
     
-    // 线程生命周期管理
+    // 线程生命周期管理（CAS 实现；不得与持有者的 enter/leave 并发调用）
     bool tryRegister(uint64_t initialEpoch) noexcept;
     void unregister() noexcept;
 
-    // EBR临界区管理
+    // EBR临界区管理：只允许槽位持有者调用，可以嵌套。
+    // 只有最外层的 enter/leave 才修改共享状态，内层只增减本地计数。
     void enter(uint64_t current_epoch) noexcept; 
     void leave() noexcept;
+    // 当前嵌套深度，0 表示不在临界区内
+    uint32_t getNestDepth() const noexcept { return nest_depth_; }
+
+    // 不计嵌套的状态切换，用普通 store 实现，不含 RMW：
+    // activate = relaxed store + 一次 seq_cst 屏障（已活跃时什么都不做）；
+    // deactivate = release store，并清零嵌套计数（用于 QSBR 下线与线程退出）
+    void activate(uint64_t current_epoch) noexcept;
+    void deactivate() noexcept;
     
-    // 纪元更新
+    // 纪元更新（只允许槽位持有者调用）
     void setEpoch(uint64_t newEpoch) noexcept;
 
     // EBR扫描器接口
     uint64_t loadState() const noexcept;
 
+    // 线程本地的 limbo bag（按 epoch % kNumRetireBags 索引），只允许槽位持有者访问
+    RetireBag& getRetireBag(size_t index) noexcept { return retire_bags_[index]; }
+    const RetireBag& getRetireBag(size_t index) const noexcept { return retire_bags_[index]; }
+    bool hasPendingRetires() const noexcept;
+
+    // 持有者 leave 的累计次数，用于摊销纪元推进（只允许槽位持有者访问）
+    uint64_t bumpLeaveCount() noexcept { return ++leave_count_; }
+
+    // 累计退休的对象数：持有者写，统计接口读（槽位复用时不清零）
+    uint64_t noteRetired() noexcept;
+    uint64_t getRetiredCount() const noexcept { return retired_count_.load(std::memory_order_relaxed); }
+
+    // --- 健壮模式的纪年区间 [lower, upper]（只允许槽位持有者写） ---
+    // 最外层 enter 之前把区间重置为当前纪年，随后的 activate 屏障负责发布
+    void reserveEra(uint64_t era) noexcept;
+    // 读到比 upper 更新的纪年时扩展区间并加屏障；区间已覆盖 era 时返回 true
+    bool extendReservation(uint64_t era) noexcept;
+    uint64_t loadReservedLower() const noexcept { return reserved_lower_.load(std::memory_order_acquire); }
+    uint64_t loadReservedUpper() const noexcept { return reserved_upper_.load(std::memory_order_acquire); }
+
     // --- 静态辅助函数 ---
     static uint64_t unpackEpoch(uint64_t state) noexcept;
     static bool isActive(uint64_t state) noexcept;
@@ -52,4 +86,11 @@ private:
     static uint64_t pack_(uint64_t epoch, bool active, bool registered) noexcept;
 
     std::atomic<uint64_t> state_;
+    RetireBag retire_bags_[kNumRetireBags];
+    uint64_t  leave_count_;
+    uint32_t  nest_depth_;
+
+    std::atomic<uint64_t> retired_count_;
+    std::atomic<uint64_t> reserved_lower_;
+    std::atomic<uint64_t> reserved_upper_;
 };
\ No newline at end of file
@@ -2,111 +2,97 @@
 
 #include <vector>
 #include <atomic>
-#include <memory>
 #include <mutex>
 
 #include "Tool/ShmMutexLock.hpp"
 #include "EBRManager/LockFreeReuseStack.hpp"
 #include "EBRManager/ThreadSlot.hpp"
-#include "EBRManager/ThreadHeapAllocator.hpp"
 
 #include <cstddef>
 #include "gc_malloc/ThreadHeap/ThreadHeap.hpp"
-
-namespace detail {
-
-// 一个用于 std::unique_ptr 的自定义删除器。
-template <typename T>
-struct ThreadHeapArrayDeleter {
-    // 删除器需要存储数组的大小，以便正确调用所有析构函数。
-    // 默认初始化为0，以处理空指针的情况。
-    size_t count = 0;
-
-    void operator()(T* ptr) const noexcept {
-        if (!ptr || count == 0) {
-            return;
-        }
-
-        for (size_t i = count; i > 0; --i) {
-            ptr[i - 1].~T();
-        }
-        ThreadHeap::deallocate(ptr);
-    }
-};
-
-} // namespace detail
-
+#include "gc_malloc/ThreadHeap/SizeClassConfig.hpp"
 
 class ThreadSlotManager {
 public:
+    // 线程退出、槽位归还前调用，让上层处理槽位上残留的线程本地状态
+    using SlotReleaseHook = void (*)(void* context, ThreadSlot* slot);
+
     ThreadSlotManager();
     ~ThreadSlotManager();
 
     ThreadSlot* getLocalSlot();
 
+    void setReleaseHook(SlotReleaseHook hook, void* context) noexcept;
+
+    // 无锁遍历全部槽位：段表只增不减，遍历过程中新增的段可能看不到，这对 EBR 扫描是安全的
+    // （新线程进入临界区时读到的一定是当前或更新的纪元）
     template<typename Callable>
     void forEachSlot(Callable func) const;
 
+    // 可写遍历：只用于没有其他线程访问槽位的场合（如管理器析构时清空 limbo bag）
+    template<typename Callable>
+    void forEachSlot(Callable func);
+
     ThreadSlotManager(const ThreadSlotManager&) = delete;
     ThreadSlotManager& operator=(const ThreadSlotManager&) = delete;
     ThreadSlotManager(ThreadSlotManager&&) = delete;
     ThreadSlotManager& operator=(ThreadSlotManager&&) = delete;
 
 private:
-    class LocalSlotProxy {
-    public:
-        LocalSlotProxy() noexcept : manager_(nullptr), slot_(nullptr) {}
-        ~LocalSlotProxy();
-
-        LocalSlotProxy(const LocalSlotProxy&) = delete;
-        LocalSlotProxy& operator=(const LocalSlotProxy&) = delete;
-
-        ThreadSlot* get() const noexcept { return slot_; }
-        bool hasSlot() const noexcept { return slot_ != nullptr; }
-
-        void acquire(ThreadSlotManager* manager, ThreadSlot* slot) {
-            manager_ = manager;
-            slot_ = slot;
-        }
-
-    private:
-        ThreadSlotManager* manager_;
-        ThreadSlot* slot_;
-    };
-
     ThreadSlot* acquireSlot_();
     void releaseSlot_(ThreadSlot* slot) noexcept;
     ThreadSlot* expandAndAcquire();
     
     static constexpr size_t kInitialCapacity = 32;
-    using Segment = std::unique_ptr<ThreadSlot, detail::ThreadHeapArrayDeleter<ThreadSlot>>;
-    using SegmentVector = std::vector<Segment, ThreadHeapAllocator<Segment>>;
+    static constexpr size_t kMaxSlotsPerSegment = SizeClassConfig::kMaxSmallAlloc / sizeof(ThreadSlot) / 2;
+    static constexpr size_t kMaxSegments = 64;
+
+    // 段表：扩容时先写好 count、再发布 slots，最后递增 segment_count_（均在 resize_lock_ 内）
+    struct Segment {
+        std::atomic<ThreadSlot*> slots;
+        size_t count;
+    };
 
     LockFreeReuseStack<ThreadSlot> free_slots_;
-    SegmentVector segments_;
+    Segment segments_[kMaxSegments];
+    std::atomic<size_t> segment_count_;
     std::atomic<size_t> capacity_;
     mutable ShmMutexLock resize_lock_;
+    const uint64_t instance_id_;
+
+    SlotReleaseHook release_hook_;
+    void* release_hook_context_;
 };
 
 
 
 template<typename Callable>
 void ThreadSlotManager::forEachSlot(Callable func) const {
-    // 加锁以确保在遍历期间 segments_ 向量不会被其他线程修改（例如扩容）。
-    // 这提供了一个稳定的、一致的快照视图。
-    std::lock_guard<ShmMutexLock> lock(resize_lock_);
-
-    // 遍历每一个内存段 (Segment)
-    // 注意：这里的拼写遵循了您的代码，但建议改为 segments_
-    for (const auto& segment : segments_) {
-        const ThreadSlot* slots_array = segment.get();
-        const size_t count = segment.get_deleter().count;
-        
-        // 遍历该内存段中的每一个槽位
+    // acquire 与扩容时的 release 配对：看到段数量就能看到段内容
+    const size_t segment_count = segment_count_.load(std::memory_order_acquire);
+
+    for (size_t s = 0; s < segment_count; ++s) {
+        const ThreadSlot* slots_array = segments_[s].slots.load(std::memory_order_relaxed);
+        const size_t count = segments_[s].count;
+
+        // 因为 forEachSlot 是 const 成员函数，所以我们传递的是 const ThreadSlot&
+        // 这保证了调用者无法在只读遍历中修改槽位状态。
+        for (size_t i = 0; i < count; ++i) {
+            func(slots_array[i]);
+        }
+    }
+}
+
+template<typename Callable>
+void ThreadSlotManager::forEachSlot(Callable func) {
+    const size_t segment_count = segment_count_.load(std::memory_order_acquire);
+
+    for (size_t s = 0; s < segment_count; ++s) {
+        ThreadSlot* slots_array = segments_[s].slots.load(std::memory_order_relaxed);
+        const size_t count = segments_[s].count;
+
         for (size_t i = 0; i < count; ++i) {
-            // 因为 forEachSlot 是 const 成员函数，所以我们传递的是 const ThreadSlot&
-            // 这保证了调用者无法在只读遍历中修改槽位状态。
             func(slots_array[i]);
         }
     }
-}
\ No newline at end of file
+}
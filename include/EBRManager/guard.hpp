@@ -5,9 +5,11 @@
 #include "EBRManager/EBRManager.hpp"
 
 namespace ebr {
+// 对任何提供 enter/leave 的回收器（EBRManager、QSBRManager）都适用；构造时自动推导类型
+template<typename Manager>
 class Guard {
 public:
-    explicit Guard(EBRManager& manager) : manager_(manager) {
+    explicit Guard(Manager& manager) : manager_(manager) {
         manager.enter();
     }
 
@@ -21,7 +23,7 @@ public:
     Guard& operator=(Guard&&) = delete;
 
 private:
-    EBRManager& manager_;
+    Manager& manager_;
 };
 
 template<typename T>
@@ -29,9 +31,21 @@ inline T* read(const std::atomic<T*>& ptr) {
     return ptr.load(std::memory_order_acquire);
 }
 
-template<typename T>
-inline void retire(EBRManager& manager, T* ptr) {
+template<typename Manager, typename T>
+inline void retire(Manager& manager, T* ptr) {
     manager.retire(ptr);
 }
 
+// 读取临界区内会被解引用的原子指针（EBRManager 健壮模式下维护保留区间）
+template<typename Manager, typename Atomic>
+inline auto load(Manager& manager, const Atomic& location) -> decltype(location.load()) {
+    return manager.protectedLoad(location);
+}
+
+// 新节点发布之前记录出生纪年
+template<typename Manager>
+inline void stampBirth(Manager& manager, EBRHook* node) {
+    manager.stampBirth(node);
+}
+
 }
\ No newline at end of file
@@ -7,6 +7,9 @@ struct DefaultHeapPolicy {
     template <class T, class... Args>
     static T* allocate(Args&&... args) {
         void* mem = ThreadHeap::allocate(sizeof(T));
+        if (!mem) {
+            return nullptr;
+        }
         return ::new (mem) T(std::forward<Args>(args)...);
     }
 
@@ -1,7 +1,24 @@
 #pragma once
 
+#include <cstdint>
+
 // 在 HazardPointer 的头文件中定义
 struct GCHook {
+    using Deleter = void (*)(GCHook*) noexcept;
+
     GCHook* gc_next = nullptr; // 专门给回收器用的指针
+    // 类型擦除的释放函数：混合多种节点类型的 HazardDomain 用它把节点交还给原来的分配器；
+    // 为空时由回收器的 AllocPolicy 经虚析构释放
+    Deleter gc_deleter = nullptr;
+    // 供 HazardEraOrganizer 使用：容器分配节点后用 stampBirth 记录出生纪元，retire 时记录退休纪元；
+    // 其他回收器忽略这两个字段
+    std::uint64_t gc_birth_era  = 0;
+    std::uint64_t gc_retire_era = 0;
     virtual ~GCHook() = default; // 虚析构，保证 delete 基类指针时能调用子类析构
-};
\ No newline at end of file
+};
+
+// 按 Node 的真实类型、用分配它的 AllocPolicy 释放
+template <class Node, class AllocPolicy>
+void gcDeleteAs(GCHook* hook) noexcept {
+    AllocPolicy::deallocate(static_cast<Node*>(hook));
+}
@@ -0,0 +1,71 @@
+// include/Hazard/HazardDomain.hpp
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "Hazard/GCHook.hpp"
+#include "Hazard/HazardPointerOrganizer.hpp"
+
+
+/**
+ * @brief 释放 GCHook 时优先调用节点自带的 gc_deleter，其余类型照常交给 AllocPolicy。
+ *
+ * 槽位块等内部对象仍然走 AllocPolicy 分配与释放。
+ */
+template <class AllocPolicy = DefaultHeapPolicy>
+struct HookDeleterPolicy {
+    template <class T, class... Args>
+    static T* allocate(Args&&... args) {
+        return AllocPolicy::template allocate<T>(std::forward<Args>(args)...);
+    }
+
+    template <class T>
+    static void deallocate(T* p) noexcept {
+        if constexpr (std::is_base_of<GCHook, T>::value) {
+            if (p && p->gc_deleter) {
+                p->gc_deleter(p);
+                return;
+            }
+        }
+        AllocPolicy::deallocate(p);
+    }
+};
+
+
+/**
+ * @brief 类型擦除的危险指针域：任何继承 GCHook 的节点都可以在同一个域中保护和退休。
+ *
+ * 多个容器（甚至不同的节点类型）共用一个域时，每个线程只占一个槽位，
+ * 一次扫描就覆盖所有容器的危险指针。节点在退休时记下自己的释放函数，
+ * 回收时按真实类型析构、交还给分配它的 AllocPolicy。
+ *
+ * MaxPointers 取共用该域的容器中所需危险指针数的最大值。
+ *
+ * 用法：
+ *   HazardDomain<> domain;
+ *   LockFreeStack<int, DefaultHeapPolicy, HazardDomain<>> stack(domain);
+ *   LockFreeQueue<int, DefaultHeapPolicy, HazardDomain<>> queue(domain);
+ */
+template <std::size_t MaxPointers = 2, class AllocPolicy = DefaultHeapPolicy>
+class HazardDomain
+    : public HazardPointerOrganizer<GCHook, MaxPointers, HookDeleterPolicy<AllocPolicy>> {
+    using Base = HazardPointerOrganizer<GCHook, MaxPointers, HookDeleterPolicy<AllocPolicy>>;
+
+public:
+    HazardDomain() = default;
+
+    // NodeAllocPolicy 是分配该节点的策略；节点已经自带 gc_deleter 时保持不变
+    template <class Node, class NodeAllocPolicy = AllocPolicy>
+    void retire(Node* node) noexcept {
+        static_assert(std::is_base_of<GCHook, Node>::value,
+                      "HazardDomain only manages GCHook-derived nodes.");
+        if (!node) return;
+        if (!node->gc_deleter) {
+            node->gc_deleter = &gcDeleteAs<Node, NodeAllocPolicy>;
+        }
+        // 按真实类型计入退休字节数
+        Base::retireSized_(node, sizeof(Node));
+    }
+};
@@ -0,0 +1,292 @@
+// include/Hazard/HazardEraOrganizer.hpp
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Hazard/AllocatorPolicies.hpp"
+#include "Hazard/GCHook.hpp"
+#include "Hazard/HeSlot.hpp"
+#include "Hazard/HpRetiredManager.hpp"
+#include "Hazard/HpSlotManager.hpp"
+#include "Tool/AsymmetricFence.hpp"
+#include "Tool/RetireBudget.hpp"
+
+
+/**
+ * @brief 危险纪元（hazard eras）回收器，接口与 HazardPointerOrganizer 相同，可以直接替换容器的 Organizer。
+ *
+ * 线程在槽位里发布的是全局纪元而不是节点指针；节点带有出生纪元（容器分配后调用 stampBirth）
+ * 和退休纪元（retire 时记录）。只要没有任何已发布的纪元落在节点的 [出生, 退休] 区间里，节点就可以释放。
+ *
+ * 与危险指针相比，遍历时纪元不变就不必写入槽位（LockFreeLinkedList::find 这类长遍历的主要开销）；
+ * 与 EBR 相比，停滞的读者只能保住它发布的纪元前后存活的节点，未回收内存仍然有界。
+ *
+ * 每个线程每退休 kEraInterval 个节点推进一次全局纪元。没有 stampBirth 的节点出生纪元为 0，
+ * 会被任何不晚于其退休纪元的发布保护——只是更保守，不会不安全。
+ */
+template <class Node, std::size_t MaxPointers, class AllocPolicy = DefaultHeapPolicy>
+class HazardEraOrganizer {
+public:
+    static_assert(std::is_base_of<GCHook, Node>::value,
+                  "HazardEraOrganizer only manages GCHook-derived nodes.");
+
+    using SlotType       = HeSlot<Node, MaxPointers>;
+    using SlotManager    = HpSlotManager<Node, MaxPointers, AllocPolicy, SlotType>;
+    using RetiredManager = HpRetiredManager<Node, AllocPolicy>;
+
+    using NodeType        = Node;
+    using AllocPolicyType = AllocPolicy;
+
+    static constexpr std::size_t kMaxPointers = MaxPointers;
+
+    // 自动扫描阈值与 HazardPointerOrganizer 相同
+    static constexpr std::size_t kScanFactor       = 2;
+    static constexpr std::size_t kMinScanThreshold = 64;
+    // 每个线程每退休这么多个节点推进一次纪元
+    static constexpr std::uint64_t kEraInterval = 64;
+
+public:
+    HazardEraOrganizer() = default;
+
+    ~HazardEraOrganizer() {
+        collect();
+        drainAllRetired();
+    }
+
+    HazardEraOrganizer(const HazardEraOrganizer&) = delete;
+    HazardEraOrganizer& operator=(const HazardEraOrganizer&) = delete;
+
+    // 节点发布之前调用
+    void stampBirth(GCHook* node) noexcept {
+        node->gc_birth_era = era_clock_.load(std::memory_order_acquire);
+    }
+
+    void retire(Node* node) noexcept;
+
+    std::uint64_t getEra() const noexcept { return era_clock_.load(std::memory_order_acquire); }
+
+    // 退休内存预算，语义与 HazardPointerOrganizer::setRetireBudget 相同
+    void setRetireBudget(std::size_t max_nodes, std::size_t max_bytes,
+                         std::chrono::nanoseconds max_backpressure = std::chrono::nanoseconds::zero()) noexcept {
+        budget_.setLimits(max_nodes, max_bytes, max_backpressure);
+    }
+    std::size_t getRetiredNodes() const noexcept { return budget_.getRetiredNodes(); }
+    std::size_t getRetiredBytes() const noexcept { return budget_.getRetiredBytes(); }
+    std::uint64_t getBudgetOverrunCount() const noexcept { return budget_.getOverrunCount(); }
+
+    std::size_t getScanThreshold() const noexcept {
+        const std::size_t threshold = kScanFactor * slot_manager_.getSlotCount() * MaxPointers;
+        return threshold < kMinScanThreshold ? kMinScanThreshold : threshold;
+    }
+
+    // 自动扫描累计释放的节点数（不含 collect / drainAllRetired 的返回值）
+    std::size_t getAutoReclaimedCount() const noexcept {
+        return auto_reclaimed_.load(std::memory_order_relaxed);
+    }
+
+    // 与 HazardPointerOrganizer::collect 相同：本线程的退休链表 + 孤儿节点；quota 只限制孤儿节点
+    std::size_t collect(std::size_t quota = 0) noexcept;
+
+    std::size_t drainAllRetired() noexcept;
+
+    SlotType* acquireTlsSlot() {
+        SlotType* slot = slot_manager_.acquireTls();
+        if (slot) {
+            slot->bindEraClock(&era_clock_);
+        }
+        return slot;
+    }
+
+private:
+    // 排好序的已发布纪元 + 少量溢出区间
+    struct EraSnapshot {
+        std::vector<std::uint64_t> eras;
+        std::vector<std::pair<std::uint64_t, std::uint64_t>> ranges;
+
+        bool protects(const GCHook* node) const noexcept {
+            // 第一个不早于出生纪元的发布，只要不晚于退休纪元就保护了节点
+            auto it = std::lower_bound(eras.begin(), eras.end(), node->gc_birth_era);
+            if (it != eras.end() && *it <= node->gc_retire_era) {
+                return true;
+            }
+            for (const auto& r : ranges) {
+                if (node->gc_birth_era <= r.second && node->gc_retire_era >= r.first) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    void snapshot_(EraSnapshot& out) const;
+    std::size_t scanLocal_(SlotType* slot) noexcept;
+    // 超出预算时调用：与 HazardPointerOrganizer 相同，扫描所有槽位的退休链表
+    std::size_t helpReclaim_() noexcept;
+    // 释放 list 中未受保护的节点（最多 quota 个，0 表示不限），其余留在 list 中
+    static std::size_t reclaimUnprotected_(Node*& list, const EraSnapshot& snapshot,
+                                           std::size_t quota = 0) noexcept;
+    static EraSnapshot& localSnapshot_() noexcept {
+        thread_local EraSnapshot snapshot;
+        return snapshot;
+    }
+
+    alignas(64) std::atomic<std::uint64_t> era_clock_{1};
+    SlotManager    slot_manager_{};
+    RetiredManager retired_manager_{};
+    std::atomic<std::size_t> auto_reclaimed_{0};
+    RetireBudget   budget_{};
+};
+
+
+template <class Node, std::size_t MaxPointers, class AllocPolicy>
+void HazardEraOrganizer<Node, MaxPointers, AllocPolicy>::retire(Node* node) noexcept {
+    if (!node) return;
+    // 节点已经摘链：此后读到的纪元不会早于任何仍可能看到它的读者发布的纪元
+    node->gc_retire_era = era_clock_.load(std::memory_order_seq_cst);
+    budget_.noteRetired(sizeof(Node));
+
+    SlotType* slot = acquireTlsSlot();
+    if (!slot) {
+        retired_manager_.appendRetiredNode(node);
+        era_clock_.fetch_add(1, std::memory_order_acq_rel);
+    } else {
+        const std::size_t count = slot->pushRetired(node);
+        if (count % kEraInterval == 0) {
+            era_clock_.fetch_add(1, std::memory_order_acq_rel);
+        }
+        if (count >= getScanThreshold()) {
+            scanLocal_(slot);
+        }
+    }
+    // 代为回收会推进纪元，刚退休的节点在下一轮背压重试时就可能释放
+    budget_.enforce([this]() noexcept { helpReclaim_(); });
+}
+
+template <class Node, std::size_t MaxPointers, class AllocPolicy>
+std::size_t HazardEraOrganizer<Node, MaxPointers, AllocPolicy>::collect(std::size_t quota) noexcept {
+    SlotType* slot = acquireTlsSlot();
+    Node* own = slot ? slot->drainAllRetired() : nullptr;
+
+    std::atomic<Node*> orphans{retired_manager_.takeAll()};
+    slot_manager_.flushOrphanedRetiredTo(orphans);
+    Node* orphan_head = orphans.load(std::memory_order_relaxed);
+    if (!own && !orphan_head) return 0;
+
+    // 显式回收时推进纪元：刚退休的节点不再与之后发布的纪元相交
+    era_clock_.fetch_add(1, std::memory_order_acq_rel);
+    AsymmetricFence::heavy();
+    EraSnapshot& snapshot = localSnapshot_();
+    snapshot_(snapshot);
+
+    std::size_t freed = 0;
+    if (own) {
+        freed += reclaimUnprotected_(own, snapshot);
+        while (own) {
+            Node* next = static_cast<Node*>(own->gc_next);
+            slot->pushRetired(own);
+            own = next;
+        }
+    }
+    if (orphan_head) {
+        freed += reclaimUnprotected_(orphan_head, snapshot, quota);
+        retired_manager_.appendRetiredList(orphan_head);
+    }
+    budget_.noteReclaimed(freed);
+    return freed;
+}
+
+template <class Node, std::size_t MaxPointers, class AllocPolicy>
+std::size_t HazardEraOrganizer<Node, MaxPointers, AllocPolicy>::helpReclaim_() noexcept {
+    std::atomic<Node*> all{retired_manager_.takeAll()};
+    slot_manager_.flushAllRetiredTo(all);
+    Node* head = all.load(std::memory_order_relaxed);
+    if (!head) return 0;
+
+    era_clock_.fetch_add(1, std::memory_order_acq_rel);
+    AsymmetricFence::heavy();
+    EraSnapshot& snapshot = localSnapshot_();
+    snapshot_(snapshot);
+
+    // 仍受保护的节点转入孤儿链表，由之后的 collect 处理
+    const std::size_t freed = reclaimUnprotected_(head, snapshot);
+    retired_manager_.appendRetiredList(head);
+    budget_.noteReclaimed(freed);
+    return freed;
+}
+
+template <class Node, std::size_t MaxPointers, class AllocPolicy>
+std::size_t HazardEraOrganizer<Node, MaxPointers, AllocPolicy>::drainAllRetired() noexcept {
+    std::atomic<Node*> collected{nullptr};
+    slot_manager_.flushAllRetiredTo(collected);
+    retired_manager_.appendRetiredList(collected.load(std::memory_order_relaxed));
+    const std::size_t freed = retired_manager_.drainAll();
+    budget_.noteReclaimed(freed);
+    return freed;
+}
+
+template <class Node, std::size_t MaxPointers, class AllocPolicy>
+void HazardEraOrganizer<Node, MaxPointers, AllocPolicy>::snapshot_(EraSnapshot& out) const {
+    out.eras.clear();
+    out.ranges.clear();
+    slot_manager_.forEachSlot([&out](SlotType& slot) {
+        slot.forEachReservation([&out](std::uint64_t lower, std::uint64_t upper) {
+            if (lower == upper) {
+                out.eras.push_back(lower);
+            } else {
+                out.ranges.emplace_back(lower, upper);
+            }
+        });
+    });
+    std::sort(out.eras.begin(), out.eras.end());
+    out.eras.erase(std::unique(out.eras.begin(), out.eras.end()), out.eras.end());
+}
+
+template <class Node, std::size_t MaxPointers, class AllocPolicy>
+std::size_t HazardEraOrganizer<Node, MaxPointers, AllocPolicy>::scanLocal_(SlotType* slot) noexcept {
+    Node* retired = slot->drainAllRetired();
+    if (!retired) return 0;
+
+    AsymmetricFence::heavy();
+    EraSnapshot& snapshot = localSnapshot_();
+    snapshot_(snapshot);
+
+    const std::size_t freed = reclaimUnprotected_(retired, snapshot);
+    while (retired) {
+        Node* next = static_cast<Node*>(retired->gc_next);
+        slot->pushRetired(retired);
+        retired = next;
+    }
+    if (freed > 0) {
+        auto_reclaimed_.fetch_add(freed, std::memory_order_relaxed);
+        budget_.noteReclaimed(freed);
+    }
+    return freed;
+}
+
+template <class Node, std::size_t MaxPointers, class AllocPolicy>
+std::size_t HazardEraOrganizer<Node, MaxPointers, AllocPolicy>::reclaimUnprotected_(
+        Node*& list, const EraSnapshot& snapshot, std::size_t quota) noexcept {
+    std::size_t freed = 0;
+    Node* kept = nullptr;
+    Node* current = list;
+    while (current) {
+        Node* next = static_cast<Node*>(current->gc_next);
+        if ((quota == 0 || freed < quota) && !snapshot.protects(current)) {
+            AllocPolicy::deallocate(current);
+            ++freed;
+        } else {
+            current->gc_next = kept;
+            kept = current;
+        }
+        current = next;
+    }
+    list = kept;
+    return freed;
+}
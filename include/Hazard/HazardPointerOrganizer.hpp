@@ -2,14 +2,16 @@
 #pragma once
 
 #include <vector>
+#include <chrono>
 #include <cstddef>
 #include <atomic>
 
 #include "Hazard/HpSlotManager.hpp"
 #include "Hazard/HpRetiredManager.hpp"
 #include "gc_malloc/ThreadHeap/ThreadHeap.hpp"
-#include "Hazard/HpSlotManagerDetail.hpp"
 #include "Hazard/GCHook.hpp"
+#include "Tool/AsymmetricFence.hpp"
+#include "Tool/RetireBudget.hpp"
 
 
 template <class Node, std::size_t MaxPointers, class AllocPolicy = DefaultHeapPolicy>
@@ -19,6 +21,11 @@ public:
     using RetiredManager = HpRetiredManager<Node, AllocPolicy>;
     using SlotType       = typename SlotManager::SlotType;
 
+    using NodeType        = Node;
+    using AllocPolicyType = AllocPolicy;
+
+    static constexpr std::size_t kMaxPointers = MaxPointers;
+
 public:
     HazardPointerOrganizer() = default;
 
@@ -30,24 +37,73 @@ public:
     HazardPointerOrganizer(const HazardPointerOrganizer&) = delete;
     HazardPointerOrganizer& operator=(const HazardPointerOrganizer&) = delete;
 
+    // 每个槽位的退休数超过 R = kScanFactor × 线程数 × MaxPointers（不低于 kMinScanThreshold）时，
+    // 自动扫描本线程的退休链表：每次扫描至少释放 R - 线程数 × MaxPointers 个节点，
+    // 每次 retire 的摊销代价为 O(1)，每个线程积压的垃圾有上界
+    static constexpr std::size_t kScanFactor       = 2;
+    static constexpr std::size_t kMinScanThreshold = 64;
+
+    // 与 HazardEraOrganizer 的容器接口对齐；危险指针不需要出生纪元
+    void stampBirth(GCHook*) noexcept {}
+
     void retire(Node* node) noexcept {
-        slot_manager_.retireNode(node);
+        retireSized_(node, sizeof(Node));
+    }
+
+    // --- 退休内存预算 ---
+    // 未释放的退休节点数或字节数超过上限（0 表示不限）时，retire 代为回收一轮：预算按整个实例计量，
+    // 所以摘下所有槽位（包括其他存活线程）的退休链表统一扫描，仍受保护的节点转入孤儿链表；
+    // max_backpressure 非 0 时仍超出预算的 retire 会反复回收、至多等待这么久（见 RetireBudget）。
+    // 只有停滞读者真正保护的节点会让预算持续超出，由 getBudgetOverrunCount 反映
+    void setRetireBudget(std::size_t max_nodes, std::size_t max_bytes,
+                         std::chrono::nanoseconds max_backpressure = std::chrono::nanoseconds::zero()) noexcept {
+        budget_.setLimits(max_nodes, max_bytes, max_backpressure);
+    }
+    std::size_t getRetiredNodes() const noexcept { return budget_.getRetiredNodes(); }
+    std::size_t getRetiredBytes() const noexcept { return budget_.getRetiredBytes(); }
+    std::uint64_t getBudgetOverrunCount() const noexcept { return budget_.getOverrunCount(); }
+
+    std::size_t getScanThreshold() const noexcept {
+        const std::size_t threshold = kScanFactor * slot_manager_.getSlotCount() * MaxPointers;
+        return threshold < kMinScanThreshold ? kMinScanThreshold : threshold;
+    }
+
+    // 自动扫描累计释放的节点数（不含 collect / drainAllRetired 的返回值）
+    std::size_t getAutoReclaimedCount() const noexcept {
+        return auto_reclaimed_.load(std::memory_order_relaxed);
     }
     
 
+    // 扫描本线程自己的退休链表，并代为处理已退出线程留下的孤儿节点；全程不加锁。
+    // 其他存活线程的退休链表由它们自己的自动扫描负责。
+    // quota 只限制孤儿节点的释放数（0 表示不限）
     std::size_t collect(std::size_t quota = 0) noexcept {
-        std::atomic<Node*> collected_list_head{nullptr};
-        slot_manager_.flushAllRetiredTo(collected_list_head);
-        
-        Node* head_ptr = collected_list_head.load(std::memory_order_relaxed);
-        if (head_ptr) {
-            retired_manager_.appendRetiredList(head_ptr);
-        }
-        
-        std::vector<const Node*> snapshot;
+        SlotType* slot = slot_manager_.acquireTls();
+        Node* own = slot ? slot->drainAllRetired() : nullptr;
+
+        // 先摘下孤儿链表，再把空闲槽位上遗留的退休链表并进来
+        std::atomic<Node*> orphans{retired_manager_.takeAll()};
+        slot_manager_.flushOrphanedRetiredTo(orphans);
+        Node* orphan_head = orphans.load(std::memory_order_relaxed);
+        if (!own && !orphan_head) return 0;
+
+        // 摘链必须先于读取危险指针：快照之后才退休的节点不会出现在这次扫描中。
+        // 读者 protect 之后只有编译器屏障，由这里的 heavy() 补上
+        AsymmetricFence::heavy();
+        // 本线程复用的快照缓冲，稳定后扫描不再分配内存
+        HazardSnapshot<Node>& snapshot = HazardSnapshot<Node>::local();
         slot_manager_.snapshotHazardpoints(snapshot);
-        
-        return retired_manager_.collectRetired(quota, snapshot);
+
+        std::size_t freed = 0;
+        if (own) {
+            freed += reclaimOwn_(slot, own, snapshot);
+        }
+        if (orphan_head) {
+            freed += RetiredManager::reclaimUnprotected(orphan_head, snapshot, quota);
+            retired_manager_.appendRetiredList(orphan_head);
+        }
+        budget_.noteReclaimed(freed);
+        return freed;
     }
 
     std::size_t drainAllRetired() noexcept {
@@ -59,16 +115,83 @@ public:
             retired_manager_.appendRetiredList(head_ptr);
         }
         
-        return retired_manager_.drainAll();
+        const std::size_t freed = retired_manager_.drainAll();
+        budget_.noteReclaimed(freed);
+        return freed;
     }
 
     SlotType* acquireTlsSlot() {
         return slot_manager_.acquireTls();
     }
-    
+
+protected:
+    // bytes 是节点的实际大小：HazardDomain 中 Node 只是 GCHook
+    void retireSized_(Node* node, std::size_t bytes) noexcept {
+        if (!node) return;
+        budget_.noteRetired(bytes);
+        SlotType* slot = slot_manager_.acquireTls();
+        if (!slot) {
+            // 槽位已用完：直接放进全局退休链表，等待 collect
+            retired_manager_.appendRetiredNode(node);
+        } else if (slot->pushRetired(node) >= getScanThreshold()) {
+            scanLocal_(slot);
+        }
+        budget_.enforce([this]() noexcept { helpReclaim_(); });
+    }
+
 private:
+    // 超出预算时调用：其他存活线程的链表可能都低于扫描阈值，只扫描本线程的链表降不下来
+    std::size_t helpReclaim_() noexcept {
+        // 与持有者的 pushRetired 并发也安全：每条链表由 exchange 整体摘走
+        std::atomic<Node*> all{retired_manager_.takeAll()};
+        slot_manager_.flushAllRetiredTo(all);
+        Node* head = all.load(std::memory_order_relaxed);
+        if (!head) return 0;
+
+        AsymmetricFence::heavy();
+        HazardSnapshot<Node>& snapshot = HazardSnapshot<Node>::local();
+        slot_manager_.snapshotHazardpoints(snapshot);
+
+        const std::size_t freed = RetiredManager::reclaimUnprotected(head, snapshot);
+        retired_manager_.appendRetiredList(head);
+        budget_.noteReclaimed(freed);
+        return freed;
+    }
+
+    // 只扫描本线程自己的退休链表，仍被保护的节点放回槽位
+    std::size_t scanLocal_(SlotType* slot) noexcept {
+        Node* retired = slot->drainAllRetired();
+        if (!retired) return 0;
+
+        // 摘链（调用方的 CAS）必须先于读取危险指针
+        AsymmetricFence::heavy();
+        HazardSnapshot<Node>& snapshot = HazardSnapshot<Node>::local();
+        slot_manager_.snapshotHazardpoints(snapshot);
+
+        const std::size_t freed = reclaimOwn_(slot, retired, snapshot);
+        if (freed > 0) {
+            auto_reclaimed_.fetch_add(freed, std::memory_order_relaxed);
+            budget_.noteReclaimed(freed);
+        }
+        return freed;
+    }
+
+    // 释放 retired 中未受保护的节点，其余放回本线程槽位
+    static std::size_t reclaimOwn_(SlotType* slot, Node* retired,
+                                   const HazardSnapshot<Node>& snapshot) noexcept {
+        const std::size_t freed = RetiredManager::reclaimUnprotected(retired, snapshot);
+        while (retired) {
+            Node* next = static_cast<Node*>(retired->gc_next);
+            slot->pushRetired(retired);
+            retired = next;
+        }
+        return freed;
+    }
+
     SlotManager    slot_manager_{};
     RetiredManager retired_manager_{};
+    std::atomic<std::size_t> auto_reclaimed_{0};
+    RetireBudget   budget_{};
 };
 
 
@@ -0,0 +1,121 @@
+// include/Hazard/HazardPtrHolder.hpp
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+#include "Tool/AsymmetricFence.hpp"
+
+
+/**
+ * @brief RAII 危险指针：构造时从本线程槽位动态领取一个下标，析构时清空并归还。
+ *
+ * 领取顺序是先内联指针、后溢出块，扫描者都能看到；因此遍历时需要多少个危险指针
+ * 就可以创建多少个 holder，不必手工分配下标。手递手遍历用 swap 交换前后两个 holder。
+ *
+ * Organizer 是 HazardPointerOrganizer、HazardDomain 或 HazardEraOrganizer；
+ * 单元里发布的内容（节点指针或纪元）由槽位的 publish 决定。
+ * 线程拿不到槽位、或槽位分配不出溢出块时 holder 无效（isValid() 为 false），
+ * protect 只读取不保护，与容器中 slot 为空时的处理一致。
+ */
+template <class Organizer>
+class HazardPtrHolder {
+public:
+    using SlotType    = typename Organizer::SlotType;
+    using Node        = typename Organizer::NodeType;
+    using AllocPolicy = typename Organizer::AllocPolicyType;
+    using CellType    = typename SlotType::CellType;
+
+    HazardPtrHolder() noexcept = default;
+
+    explicit HazardPtrHolder(Organizer& organizer)
+        : slot_(organizer.acquireTlsSlot()) {
+        if (slot_) {
+            index_ = slot_->template acquireIndex<AllocPolicy>();
+            if (index_ == SlotType::kInvalidIndex) {
+                slot_ = nullptr;
+                return;
+            }
+            cell_ = &slot_->getHazardCell(index_);
+        }
+    }
+
+    ~HazardPtrHolder() { release_(); }
+
+    HazardPtrHolder(const HazardPtrHolder&)            = delete;
+    HazardPtrHolder& operator=(const HazardPtrHolder&) = delete;
+
+    HazardPtrHolder(HazardPtrHolder&& other) noexcept
+        : slot_(std::exchange(other.slot_, nullptr)),
+          index_(other.index_),
+          cell_(std::exchange(other.cell_, nullptr)) {}
+
+    HazardPtrHolder& operator=(HazardPtrHolder&& other) noexcept {
+        if (this != &other) {
+            release_();
+            slot_  = std::exchange(other.slot_, nullptr);
+            index_ = other.index_;
+            cell_  = std::exchange(other.cell_, nullptr);
+        }
+        return *this;
+    }
+
+    bool isValid() const noexcept { return cell_ != nullptr; }
+
+    // 读取 src 并保护，直到重读确认它没有变化；返回受保护的值
+    template <class T>
+    T* protect(const std::atomic<T*>& src) noexcept {
+        return protect(src, [](T* p) noexcept { return p; });
+    }
+
+    // to_ptr 把 src 中的原始值（可能带标记位）转换为要保护的节点指针；返回原始值
+    template <class T, class Func>
+    T* protect(const std::atomic<T*>& src, Func to_ptr) noexcept {
+        T* raw = src.load(std::memory_order_relaxed);
+        for (;;) {
+            reset(to_ptr(raw));
+            // protect 的写入必须先于重读，与回收者的 AsymmetricFence::heavy() 配对
+            AsymmetricFence::light();
+            T* again = src.load(std::memory_order_acquire);
+            if (again == raw) {
+                return raw;
+            }
+            raw = again;
+        }
+    }
+
+    // 直接发布 p，调用方自行验证
+    template <class T>
+    void reset(T* p) noexcept {
+        if (cell_) {
+            slot_->publish(*cell_, p);
+        }
+    }
+
+    void reset() noexcept {
+        if (cell_) {
+            slot_->publish(*cell_, nullptr);
+        }
+    }
+
+    // 交换两个 holder 保护的指针（实际交换的是下标），不会出现未受保护的空档
+    void swap(HazardPtrHolder& other) noexcept {
+        std::swap(slot_, other.slot_);
+        std::swap(index_, other.index_);
+        std::swap(cell_, other.cell_);
+    }
+
+private:
+    void release_() noexcept {
+        if (cell_) {
+            slot_->releaseIndex(index_);
+            slot_ = nullptr;
+            cell_ = nullptr;
+        }
+    }
+
+    SlotType*           slot_{nullptr};
+    std::size_t         index_{0};
+    CellType*           cell_{nullptr};
+};
@@ -0,0 +1,79 @@
+// hazard/hazard_snapshot.hpp
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 一次扫描得到的危险指针快照：排好序的扁平数组 + 无分支二分查找。
+ *
+ * 每个线程对每种 Node 复用同一个缓冲（local()），容量只增不减，
+ * 稳定运行后扫描不再分配内存；查找只在连续数组上做 log2(n) 次比较，
+ * 没有哈希，也没有难以预测的分支。
+ *
+ * 用法：clear() -> 若干次 push() -> seal() -> 多次 contains()。
+ */
+template <class Node>
+class HazardSnapshot {
+public:
+    HazardSnapshot() = default;
+    ~HazardSnapshot() = default;
+
+    HazardSnapshot(const HazardSnapshot&) = delete;
+    HazardSnapshot& operator=(const HazardSnapshot&) = delete;
+
+    void clear() noexcept { ptrs_.clear(); sealed_ = false; }
+    void reserve(std::size_t n) { ptrs_.reserve(n); }
+    void push(const Node* p) { ptrs_.push_back(p); sealed_ = false; }
+
+    // 排序并去重；之后才能调用 contains
+    void seal() noexcept;
+    bool contains(const Node* p) const noexcept;
+
+    std::size_t size() const noexcept { return ptrs_.size(); }
+    bool isEmpty() const noexcept { return ptrs_.empty(); }
+
+    // 当前线程可复用的快照缓冲
+    static HazardSnapshot& local() noexcept;
+
+private:
+    static std::uintptr_t key_(const Node* p) noexcept { return reinterpret_cast<std::uintptr_t>(p); }
+
+    std::vector<const Node*> ptrs_;
+    bool                     sealed_{true};
+};
+
+
+template <class Node>
+void HazardSnapshot<Node>::seal() noexcept {
+    std::sort(ptrs_.begin(), ptrs_.end(), [](const Node* a, const Node* b) {
+        return key_(a) < key_(b);
+    });
+    ptrs_.erase(std::unique(ptrs_.begin(), ptrs_.end()), ptrs_.end());
+    sealed_ = true;
+}
+
+template <class Node>
+bool HazardSnapshot<Node>::contains(const Node* p) const noexcept {
+    assert(sealed_ && "HazardSnapshot::seal() must be called before contains().");
+    std::size_t n = ptrs_.size();
+    if (n == 0) return false;
+
+    // 每轮只根据比较结果挑选下一个 base，编译器生成条件传送而不是跳转
+    const Node* const* base = ptrs_.data();
+    const std::uintptr_t k  = key_(p);
+    while (n > 1) {
+        const std::size_t half = n / 2;
+        base = (key_(base[half]) <= k) ? base + half : base;
+        n -= half;
+    }
+    return *base == p;
+}
+
+template <class Node>
+HazardSnapshot<Node>& HazardSnapshot<Node>::local() noexcept {
+    thread_local HazardSnapshot snapshot;
+    return snapshot;
+}
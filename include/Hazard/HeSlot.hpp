@@ -0,0 +1,217 @@
+// include/Hazard/HeSlot.hpp
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "Hazard/GCHook.hpp"
+
+// 危险纪元槽位：与 HpSlot 的登记方式、退休链表完全相同，
+// 只是每个下标发布的是读取节点时的全局纪元，而不是节点指针。
+//
+// 一个纪元 e 保护所有 [出生纪元, 退休纪元] 覆盖 e 的节点，所以遍历时纪元不变就不必重新发布，
+// 手递手前进只是一次纪元比较；纪元变化时才写入新的值。
+//
+// 动态下标用完 MaxPointers 个内联纪元后共用一个溢出区间 [lower, upper]：
+// 区间只扩不缩，直到最后一个溢出下标归还才清空（与区间回收 IBR 的保留区间相同）。
+template<class Node, std::size_t MaxPointers>
+class alignas(64) HeSlot {
+public:
+    static_assert(MaxPointers <= 64, "Inline hazard eras are tracked by a 64-bit mask.");
+
+    // 0 表示未发布；全局纪元从 1 开始
+    static constexpr std::uint64_t kNoEra = 0;
+    // 所有超出内联数量的动态下标共用的溢出下标
+    static constexpr std::size_t kOverflowIndex = MaxPointers;
+    // 接口与 HpSlot 保持一致；溢出下标不需要分配内存，acquireIndex 不会失败
+    static constexpr std::size_t kInvalidIndex = static_cast<std::size_t>(-1);
+
+    using CellType = std::atomic<std::uint64_t>;
+
+    HeSlot() = default;
+    ~HeSlot() = default;
+
+    HeSlot(const HeSlot&) = delete;
+    HeSlot& operator=(const HeSlot&) = delete;
+
+    bool tryAcquire() noexcept;
+    void release() noexcept;
+    bool isInUse() const noexcept { return in_use_.load(std::memory_order_acquire); }
+
+    // 纪元时钟由 HazardEraOrganizer 在线程取得槽位时绑定
+    void bindEraClock(const std::atomic<std::uint64_t>* clock) noexcept { era_clock_ = clock; }
+
+    // 与 HpSlot 相同的固定下标接口：p 非空时发布当前纪元
+    void protect(std::size_t index, Node* p) noexcept;
+    void clear(std::size_t index) noexcept;
+    void clearAll() noexcept;
+
+    // 动态下标（仅持有线程调用），供 HazardPtrHolder 使用
+    template<class AllocPolicy>
+    std::size_t acquireIndex() noexcept;
+    void releaseIndex(std::size_t index) noexcept;
+    CellType& getHazardCell(std::size_t index) noexcept;
+    void publish(CellType& cell, const Node* p) noexcept;
+
+    // 遍历所有已发布的保留区间 [lower, upper]（内联纪元的区间只有一个点），供扫描者使用
+    template<class Callable>
+    void forEachReservation(Callable func) const;
+
+    // 没有溢出块，接口与 HpSlot 保持一致
+    template<class AllocPolicy>
+    void freeOverflow() noexcept {}
+
+    std::size_t pushRetired(Node* n) noexcept;
+    Node* drainAllRetired() noexcept;
+    std::size_t getRetiredCount() const noexcept;
+    std::atomic<GCHook*>& getRetiredListHead() noexcept { return retired_head_; }
+
+private:
+    std::uint64_t currentEra_() const noexcept {
+        return era_clock_->load(std::memory_order_acquire);
+    }
+
+    CellType eras_[MaxPointers]{};
+    CellType overflow_lower_{kNoEra};
+    CellType overflow_upper_{kNoEra};
+
+    std::atomic<GCHook*>     retired_head_{nullptr};
+    std::atomic<std::size_t> retired_count_{0};   // 近似值
+    std::atomic<bool>        in_use_{false};
+
+    // 以下只由持有线程读写
+    const std::atomic<std::uint64_t>* era_clock_{nullptr};
+    std::uint64_t inline_used_mask_{0};
+    std::size_t   overflow_users_{0};
+};
+
+
+template<class Node, std::size_t MaxPointers>
+bool HeSlot<Node, MaxPointers>::tryAcquire() noexcept {
+    bool expected = false;
+    return !in_use_.load(std::memory_order_relaxed) &&
+           in_use_.compare_exchange_strong(expected, true,
+                                           std::memory_order_acquire,
+                                           std::memory_order_relaxed);
+}
+
+template<class Node, std::size_t MaxPointers>
+void HeSlot<Node, MaxPointers>::release() noexcept {
+    // 退休链表留在槽位上，由下一个持有者或 collect 处理
+    clearAll();
+    inline_used_mask_ = 0;
+    overflow_users_   = 0;
+    in_use_.store(false, std::memory_order_release);
+}
+
+template<class Node, std::size_t MaxPointers>
+void HeSlot<Node, MaxPointers>::protect(std::size_t index, Node* p) noexcept {
+    assert(index < MaxPointers && "Hazard era index is out of bounds.");
+    publish(eras_[index], p);
+}
+
+template<class Node, std::size_t MaxPointers>
+void HeSlot<Node, MaxPointers>::clear(std::size_t index) noexcept {
+    assert(index < MaxPointers && "Hazard era index is out of bounds.");
+    eras_[index].store(kNoEra, std::memory_order_release);
+}
+
+template<class Node, std::size_t MaxPointers>
+void HeSlot<Node, MaxPointers>::clearAll() noexcept {
+    for (auto& era : eras_) {
+        era.store(kNoEra, std::memory_order_release);
+    }
+    overflow_upper_.store(kNoEra, std::memory_order_release);
+    overflow_lower_.store(kNoEra, std::memory_order_release);
+}
+
+template<class Node, std::size_t MaxPointers>
+template<class AllocPolicy>
+std::size_t HeSlot<Node, MaxPointers>::acquireIndex() noexcept {
+    for (std::size_t i = 0; i < MaxPointers; ++i) {
+        if ((inline_used_mask_ & (std::uint64_t{1} << i)) == 0) {
+            inline_used_mask_ |= std::uint64_t{1} << i;
+            return i;
+        }
+    }
+    ++overflow_users_;
+    return kOverflowIndex;
+}
+
+template<class Node, std::size_t MaxPointers>
+void HeSlot<Node, MaxPointers>::releaseIndex(std::size_t index) noexcept {
+    if (index < MaxPointers) {
+        eras_[index].store(kNoEra, std::memory_order_release);
+        inline_used_mask_ &= ~(std::uint64_t{1} << index);
+        return;
+    }
+    if (--overflow_users_ == 0) {
+        // 先清上界：扫描者先读下界、后读上界，看到上界为空就忽略这个区间
+        overflow_upper_.store(kNoEra, std::memory_order_release);
+        overflow_lower_.store(kNoEra, std::memory_order_release);
+    }
+}
+
+template<class Node, std::size_t MaxPointers>
+auto HeSlot<Node, MaxPointers>::getHazardCell(std::size_t index) noexcept -> CellType& {
+    return index < MaxPointers ? eras_[index] : overflow_upper_;
+}
+
+template<class Node, std::size_t MaxPointers>
+void HeSlot<Node, MaxPointers>::publish(CellType& cell, const Node* p) noexcept {
+    const bool overflow = &cell == &overflow_upper_;
+    if (!p) {
+        // 溢出区间由多个 holder 共用，只在最后一个归还时清空
+        if (!overflow) cell.store(kNoEra, std::memory_order_release);
+        return;
+    }
+    // 节点在读到它之前就已出生：出生纪元不会大于此刻的纪元
+    const std::uint64_t era = currentEra_();
+    if (overflow && overflow_lower_.load(std::memory_order_relaxed) == kNoEra) {
+        overflow_lower_.store(era, std::memory_order_release);
+    }
+    // 纪元没有变化就不写：热路径上只有一次比较
+    if (cell.load(std::memory_order_relaxed) != era) {
+        cell.store(era, std::memory_order_release);
+    }
+}
+
+template<class Node, std::size_t MaxPointers>
+template<class Callable>
+void HeSlot<Node, MaxPointers>::forEachReservation(Callable func) const {
+    for (const auto& cell : eras_) {
+        const std::uint64_t era = cell.load(std::memory_order_acquire);
+        if (era != kNoEra) func(era, era);
+    }
+    // 下界为空而上界非空时，下界可能刚被写入：保守地从最早的纪元算起
+    const std::uint64_t lower = overflow_lower_.load(std::memory_order_acquire);
+    const std::uint64_t upper = overflow_upper_.load(std::memory_order_acquire);
+    if (upper != kNoEra) {
+        func(lower == kNoEra ? std::uint64_t{1} : lower, upper);
+    }
+}
+
+template<class Node, std::size_t MaxPointers>
+std::size_t HeSlot<Node, MaxPointers>::pushRetired(Node* n) noexcept {
+    GCHook* hook = static_cast<GCHook*>(n);
+    GCHook* old_head = retired_head_.load(std::memory_order_relaxed);
+    do {
+        hook->gc_next = old_head;
+    } while (!retired_head_.compare_exchange_weak(old_head, hook,
+                                                  std::memory_order_release,
+                                                  std::memory_order_relaxed));
+    return retired_count_.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+template<class Node, std::size_t MaxPointers>
+Node* HeSlot<Node, MaxPointers>::drainAllRetired() noexcept {
+    GCHook* head = retired_head_.exchange(nullptr, std::memory_order_acq_rel);
+    retired_count_.store(0, std::memory_order_relaxed);
+    return static_cast<Node*>(head);
+}
+
+template<class Node, std::size_t MaxPointers>
+std::size_t HeSlot<Node, MaxPointers>::getRetiredCount() const noexcept {
+    return retired_count_.load(std::memory_order_relaxed);
+}
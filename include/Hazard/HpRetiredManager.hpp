@@ -3,12 +3,18 @@
 #include <cstddef>
 #include <cstdint>
 #include <atomic>
-#include <mutex>
 #include <vector>
 
-#include "Tool/ShmMutexLock.hpp"
 #include "AllocatorPolicies.hpp"
-
+#include "HazardSnapshot.hpp"
+
+/**
+ * @brief 孤儿退休链表：存放已退出线程留下、或槽位不足时无处存放的退休节点。
+ *
+ * 各线程平时只扫描自己槽位上的退休链表，这里只是兜底。
+ * 链表是无锁栈：追加用 CAS 压入整段，扫描者用 exchange 一次摘下整条链，
+ * 扫描后把仍受保护的节点压回去；多个扫描者拿到的是互不相交的链，不需要互斥锁。
+ */
 template <class Node, class AllocPolicy = DefaultHeapPolicy>
 class HpRetiredManager {
 public:
@@ -24,21 +30,31 @@ public:
     void appendRetiredNode(Node* n) noexcept;
     void appendRetiredList(Node* head) noexcept;
 
-                        
+    // 释放不在快照中的退休节点（至多 quota 个，0 表示不限）
+    std::size_t collectRetired(std::size_t                   quota,
+                               const HazardSnapshot<Node>&   hazard_snapshot) noexcept;
+    // 兼容接口：先把 vector 整理进本线程的快照缓冲
     std::size_t collectRetired(std::size_t                 quota,
                                const std::vector<const Node*>&   hazard_snapshot) noexcept;
 
     std::size_t drainAll() noexcept;
+
+    // 摘下整条孤儿链表交给调用方扫描；扫描后剩下的节点用 appendRetiredList 放回
+    Node* takeAll() noexcept;
+
+    // 释放 head 链表中不在快照里的节点（至多 quota 个，0 表示不限），
+    // head 改为剩下的节点；返回释放的数量
+    static std::size_t reclaimUnprotected(Node*&                      head,
+                                          const HazardSnapshot<Node>& hazard_snapshot,
+                                          std::size_t                 quota = 0) noexcept;
     std::size_t getRetiredCount() const noexcept;
 
 private:
-    std::size_t appendListLocked_(Node* head) noexcept;
-    std::size_t scanAndReclaimLocked_(std::size_t      quota,
-                                      const std::vector<const Node*>& hazard_snapshot) noexcept;
+    // 把 [head, tail] 整段压入链表
+    void pushList_(Node* head, Node* tail) noexcept;
 
 private:
-    mutable ShmMutexLock        lock_;
-    Node*                       global_head_{nullptr};
+    std::atomic<Node*>          global_head_{nullptr};
     std::atomic<std::size_t>    approx_count_{0};
 
 };
@@ -2,7 +2,6 @@
 #pragma once
 
 #include <cassert>
-#include <unordered_set>
 
 // ========== 修复点 1：改成模板函数 ==========
 // 这样编译器就能推导出 Node 类型，而不需要在类外部预先定义 Node
@@ -28,37 +27,48 @@ HpRetiredManager<Node, AllocPolicy>::~HpRetiredManager() noexcept = default;
 template <class Node, class AllocPolicy>
 void HpRetiredManager<Node, AllocPolicy>::appendRetiredNode(Node* n) noexcept {
     if (!n) return;
-    std::lock_guard<ShmMutexLock> guard(lock_);
-    n->gc_next = global_head_; 
-    global_head_ = n;
+    pushList_(n, n);
     approx_count_.fetch_add(1, std::memory_order_relaxed);
 }
 
 template <class Node, class AllocPolicy>
 void HpRetiredManager<Node, AllocPolicy>::appendRetiredList(Node* head) noexcept {
     if (!head) return;
-    std::lock_guard<ShmMutexLock> guard(lock_);
-    appendListLocked_(head);
+    Node* tail = head;
+    std::size_t count = 1;
+    while (tail->gc_next) {
+        tail = static_cast<Node*>(tail->gc_next);
+        count++;
+    }
+    pushList_(head, tail);
+    approx_count_.fetch_add(count, std::memory_order_relaxed);
 }
 
 template <class Node, class AllocPolicy>
 std::size_t HpRetiredManager<Node, AllocPolicy>::collectRetired(std::size_t quota, const std::vector<const Node*>& hazard_snapshot) noexcept {
-    if (quota == 0) {
-        quota = static_cast<std::size_t>(-1); 
+    HazardSnapshot<Node>& snapshot = HazardSnapshot<Node>::local();
+    snapshot.clear();
+    for (const Node* p : hazard_snapshot) {
+        snapshot.push(p);
     }
-    std::lock_guard<ShmMutexLock> guard(lock_);
-    return scanAndReclaimLocked_(quota, hazard_snapshot);
+    snapshot.seal();
+    return collectRetired(quota, snapshot);
+}
+
+template <class Node, class AllocPolicy>
+std::size_t HpRetiredManager<Node, AllocPolicy>::collectRetired(std::size_t quota, const HazardSnapshot<Node>& hazard_snapshot) noexcept {
+    Node* list = takeAll();
+    if (!list) return 0;
+
+    const std::size_t freed_count = reclaimUnprotected(list, hazard_snapshot, quota);
+    appendRetiredList(list);
+    return freed_count;
 }
 
 
 template <class Node, class AllocPolicy>
 std::size_t HpRetiredManager<Node, AllocPolicy>::drainAll() noexcept {
-    Node* list_to_drain = nullptr;
-    {
-        std::lock_guard<ShmMutexLock> guard(lock_);
-        list_to_drain = std::exchange(global_head_, nullptr);
-    }
-
+    Node* list_to_drain = takeAll();
     if (!list_to_drain) return 0;
 
     std::size_t freed_count = 0;
@@ -70,72 +80,65 @@ std::size_t HpRetiredManager<Node, AllocPolicy>::drainAll() noexcept {
         current = next;
         freed_count++;
     }
-
-    if (freed_count > 0) {
-        approx_count_.fetch_sub(freed_count, std::memory_order_relaxed);
-    }
     return freed_count;
 }
 
-
-
 template <class Node, class AllocPolicy>
-std::size_t HpRetiredManager<Node, AllocPolicy>::getRetiredCount() const noexcept {
-    return approx_count_.load(std::memory_order_relaxed);
-}
+Node* HpRetiredManager<Node, AllocPolicy>::takeAll() noexcept {
+    if (global_head_.load(std::memory_order_relaxed) == nullptr) return nullptr;
 
-// ========== 私有区（已持锁版本） ==========
-
-template <class Node, class AllocPolicy>
-size_t HpRetiredManager<Node, AllocPolicy>::appendListLocked_(Node* head) noexcept {
-    Node* tail = head;
-    std::size_t count = 1;
-    while (tail && tail->gc_next) {
-        tail = static_cast<Node*>(tail->gc_next);
+    // exchange 独占整条链，与其他扫描者互不干扰
+    Node* head = global_head_.exchange(nullptr, std::memory_order_acquire);
+    std::size_t count = 0;
+    for (Node* p = head; p; p = static_cast<Node*>(p->gc_next)) {
         count++;
     }
-    if (tail) {
-        tail->gc_next = global_head_;
-        global_head_ = head;
-        approx_count_.fetch_add(count, std::memory_order_relaxed);
+    if (count > 0) {
+        approx_count_.fetch_sub(count, std::memory_order_relaxed);
     }
-
-    return count;
+    return head;
 }
 
 
 template <class Node, class AllocPolicy>
-std::size_t HpRetiredManager<Node, AllocPolicy>::scanAndReclaimLocked_(
-    std::size_t quota, const std::vector<const Node*>& hazard_snapshot) noexcept 
+std::size_t HpRetiredManager<Node, AllocPolicy>::reclaimUnprotected(
+    Node*& head, const HazardSnapshot<Node>& hazard_snapshot, std::size_t quota) noexcept
 {
-    if (!global_head_) return 0;
-
-    std::unordered_set<const Node*> hazard_set(hazard_snapshot.begin(), hazard_snapshot.end());
-    
-    Node dummy_head{};
-    dummy_head.gc_next = global_head_;
-    Node* prev = &dummy_head;
-    Node* current = global_head_;
+    if (quota == 0) {
+        quota = static_cast<std::size_t>(-1);
+    }
+    Node* kept = nullptr;
     std::size_t freed_count = 0;
-
-    while (current && freed_count < quota) {
+    Node* current = head;
+    while (current) {
         Node* next = static_cast<Node*>(current->gc_next);
-        if (hazard_set.find(current) == hazard_set.end()) {
-            prev->gc_next = next;
-            // *** 使用与 HpSlotManager 一致的 AllocPolicy 进行回收 ***
+        if (freed_count >= quota || hazard_snapshot.contains(current)) {
+            current->gc_next = kept;
+            kept = current;
+        } else {
             AllocPolicy::deallocate(current);
             freed_count++;
-            current = next;
-        } else {
-            prev = current;
-            current = next;
         }
+        current = next;
     }
-
-    global_head_ = static_cast<Node*>(dummy_head.gc_next);
-    if (freed_count > 0) {
-        approx_count_.fetch_sub(freed_count, std::memory_order_relaxed);
-    }
+    head = kept;
     return freed_count;
 }
 
+template <class Node, class AllocPolicy>
+std::size_t HpRetiredManager<Node, AllocPolicy>::getRetiredCount() const noexcept {
+    return approx_count_.load(std::memory_order_relaxed);
+}
+
+// ========== 私有区 ==========
+
+template <class Node, class AllocPolicy>
+void HpRetiredManager<Node, AllocPolicy>::pushList_(Node* head, Node* tail) noexcept {
+    // 只压入、摘取整条链，不存在 ABA
+    Node* old_head = global_head_.load(std::memory_order_relaxed);
+    do {
+        tail->gc_next = old_head;
+    } while (!global_head_.compare_exchange_weak(old_head, head,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed));
+}
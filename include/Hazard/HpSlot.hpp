@@ -8,21 +8,64 @@
 
 #include "Hazard/GCHook.hpp"
 
+// 独占缓存行：扫描者顺序读取相邻槽位时，不与其他线程的 protect 写入伪共享。
+//
+// 危险指针分两部分：MaxPointers 个内联指针（固定下标，热路径直接使用），
+// 以及按需追加的溢出块（只由持有线程追加，扫描者沿链表读取）。
+// acquireIndex/releaseIndex 动态分配下标，一般通过 HazardPtrHolder 使用；
+// 同一线程不要把固定下标与动态分配的下标混在同一段代码里使用。
 template<class Node, std::size_t MaxPointers>
-class HpSlot {
+class alignas(64) HpSlot {
 public:
+    static_assert(MaxPointers <= 64, "Inline hazard pointers are tracked by a 64-bit mask.");
+
+    // 每个溢出块容纳的危险指针数
+    static constexpr std::size_t kOverflowBlockSize = 16;
+    // acquireIndex 分配溢出块失败时返回的下标
+    static constexpr std::size_t kInvalidIndex = static_cast<std::size_t>(-1);
+
+    // getHazardCell 返回的单元类型；HazardPtrHolder 通过 publish 写入
+    using CellType = std::atomic<Node*>;
+
     HpSlot() = default;
+    // 溢出块由 freeOverflow 释放（需要知道分配它们的 AllocPolicy）
     ~HpSlot() = default;
 
     HpSlot(const HpSlot&) = delete;
     HpSlot& operator=(const HpSlot&) = delete;
 
+    // 槽位占用标记：线程第一次使用时 CAS 占用，线程退出时清空危险指针后归还
+    bool tryAcquire() noexcept;
+    void release() noexcept;
+    bool isInUse() const noexcept { return in_use_.load(std::memory_order_acquire); }
+
     void protect(std::size_t index, Node* p) noexcept;
     void clear(std::size_t index) noexcept;
     void clearAll() noexcept;
 
-    void pushRetired(Node* n) noexcept;
+    // 动态下标（仅持有线程调用）：先找空闲的内联指针，再找溢出块，必要时追加新的溢出块；
+    // 溢出块分配失败时返回 kInvalidIndex
+    template<class AllocPolicy>
+    std::size_t acquireIndex();
+    void releaseIndex(std::size_t index) noexcept;
+    // 下标对应的危险指针；溢出下标需要沿链表查找，调用方应缓存返回值
+    std::atomic<Node*>& getHazardCell(std::size_t index) noexcept;
+    // 在 getHazardCell 取得的单元中发布 p（nullptr 表示清除）
+    void publish(CellType& cell, Node* p) noexcept { cell.store(p, std::memory_order_release); }
+
+    // 遍历所有非空危险指针（内联 + 溢出），供扫描者使用
+    template<class Callable>
+    void forEachHazard(Callable func) const;
+
+    // 释放全部溢出块，只在没有其他线程访问槽位时调用
+    template<class AllocPolicy>
+    void freeOverflow() noexcept;
+
+    // 返回压入后本槽位的退休计数
+    std::size_t pushRetired(Node* n) noexcept;
+    // 摘下整条退休链表并清零计数
     Node* drainAllRetired() noexcept;
+    std::size_t getRetiredCount() const noexcept;
 
     std::size_t getHazardPointerCount() const noexcept;
     
@@ -30,11 +73,145 @@ public:
     const std::atomic<Node*>& getHazardPointerAt(std::size_t index) const noexcept;
     
 private: 
+    struct OverflowBlock {
+        std::atomic<Node*>          ptrs[kOverflowBlockSize];
+        std::atomic<OverflowBlock*> next{nullptr};   // 指向更早追加的块
+        std::uint32_t               used_mask{0};    // 只由持有线程读写
+
+        OverflowBlock() noexcept {
+            for (auto& p : ptrs) p.store(nullptr, std::memory_order_relaxed);
+        }
+    };
+
     std::array<std::atomic<Node*>, MaxPointers> hazard_ptrs_{};
     std::atomic<GCHook*> retired_head{nullptr}; // 本线程退休链表头（直接 Node*）
+    std::atomic<std::size_t> retired_count_{0};  // 近似值：与 drainAllRetired 并发时可能略有偏差
+    std::atomic<bool> in_use_{false};
+
+    // 以下只由持有线程修改；换手时由 in_use_ 的 release/acquire 同步
+    std::uint64_t inline_used_mask_{0};
+    std::size_t   overflow_count_{0};
+    std::atomic<OverflowBlock*> overflow_head_{nullptr};   // 最新追加的块
 };
 
 
+template<class Node, std::size_t MaxPointers>
+bool HpSlot<Node, MaxPointers>::tryAcquire() noexcept {
+    bool expected = false;
+    return !in_use_.load(std::memory_order_relaxed) &&
+           in_use_.compare_exchange_strong(expected, true,
+                                           std::memory_order_acquire,
+                                           std::memory_order_relaxed);
+}
+
+template<class Node, std::size_t MaxPointers>
+void HpSlot<Node, MaxPointers>::release() noexcept {
+    // 退休链表留在槽位上，由下一个持有者或 collect 处理；溢出块保留给下一个持有者
+    clearAll();
+    inline_used_mask_ = 0;
+    for (OverflowBlock* b = overflow_head_.load(std::memory_order_relaxed); b;
+         b = b->next.load(std::memory_order_relaxed)) {
+        b->used_mask = 0;
+    }
+    in_use_.store(false, std::memory_order_release);
+}
+
+
+template<class Node, std::size_t MaxPointers>
+template<class AllocPolicy>
+std::size_t HpSlot<Node, MaxPointers>::acquireIndex() {
+    for (std::size_t i = 0; i < MaxPointers; ++i) {
+        if ((inline_used_mask_ & (std::uint64_t{1} << i)) == 0) {
+            inline_used_mask_ |= std::uint64_t{1} << i;
+            return i;
+        }
+    }
+
+    // 溢出块从新到旧编号为 overflow_count_-1 ... 0
+    std::size_t block_no = overflow_count_;
+    for (OverflowBlock* b = overflow_head_.load(std::memory_order_relaxed); b;
+         b = b->next.load(std::memory_order_relaxed)) {
+        --block_no;
+        for (std::size_t j = 0; j < kOverflowBlockSize; ++j) {
+            if ((b->used_mask & (1u << j)) == 0) {
+                b->used_mask |= 1u << j;
+                return MaxPointers + block_no * kOverflowBlockSize + j;
+            }
+        }
+    }
+
+    OverflowBlock* block = AllocPolicy::template allocate<OverflowBlock>();
+    if (!block) {
+        return kInvalidIndex;
+    }
+    block->used_mask = 1u;
+    block->next.store(overflow_head_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    // release 与扫描者的 acquire 配对：看到新块就能看到它已清空的指针
+    overflow_head_.store(block, std::memory_order_release);
+    return MaxPointers + (overflow_count_++) * kOverflowBlockSize;
+}
+
+template<class Node, std::size_t MaxPointers>
+void HpSlot<Node, MaxPointers>::releaseIndex(std::size_t index) noexcept {
+    getHazardCell(index).store(nullptr, std::memory_order_release);
+    if (index < MaxPointers) {
+        inline_used_mask_ &= ~(std::uint64_t{1} << index);
+        return;
+    }
+    const std::size_t target = (index - MaxPointers) / kOverflowBlockSize;
+    std::size_t block_no = overflow_count_;
+    for (OverflowBlock* b = overflow_head_.load(std::memory_order_relaxed); b;
+         b = b->next.load(std::memory_order_relaxed)) {
+        if (--block_no == target) {
+            b->used_mask &= ~(1u << ((index - MaxPointers) % kOverflowBlockSize));
+            return;
+        }
+    }
+}
+
+template<class Node, std::size_t MaxPointers>
+std::atomic<Node*>& HpSlot<Node, MaxPointers>::getHazardCell(std::size_t index) noexcept {
+    if (index < MaxPointers) {
+        return hazard_ptrs_[index];
+    }
+    const std::size_t target = (index - MaxPointers) / kOverflowBlockSize;
+    std::size_t block_no = overflow_count_;
+    OverflowBlock* b = overflow_head_.load(std::memory_order_relaxed);
+    while (--block_no != target) {
+        b = b->next.load(std::memory_order_relaxed);
+    }
+    return b->ptrs[(index - MaxPointers) % kOverflowBlockSize];
+}
+
+template<class Node, std::size_t MaxPointers>
+template<class Callable>
+void HpSlot<Node, MaxPointers>::forEachHazard(Callable func) const {
+    for (const auto& hp_atomic : hazard_ptrs_) {
+        const Node* ptr = hp_atomic.load(std::memory_order_acquire);
+        if (ptr) func(ptr);
+    }
+    for (const OverflowBlock* b = overflow_head_.load(std::memory_order_acquire); b;
+         b = b->next.load(std::memory_order_acquire)) {
+        for (const auto& hp_atomic : b->ptrs) {
+            const Node* ptr = hp_atomic.load(std::memory_order_acquire);
+            if (ptr) func(ptr);
+        }
+    }
+}
+
+template<class Node, std::size_t MaxPointers>
+template<class AllocPolicy>
+void HpSlot<Node, MaxPointers>::freeOverflow() noexcept {
+    OverflowBlock* b = overflow_head_.exchange(nullptr, std::memory_order_relaxed);
+    while (b) {
+        OverflowBlock* next = b->next.load(std::memory_order_relaxed);
+        AllocPolicy::deallocate(b);
+        b = next;
+    }
+    overflow_count_ = 0;
+}
+
+
 template<class Node, std::size_t MaxPointers>
 std::size_t HpSlot<Node, MaxPointers>::getHazardPointerCount() const noexcept {
     return MaxPointers;
@@ -64,10 +241,16 @@ void HpSlot<Node, MaxPointers>::clear(std::size_t index) noexcept {
 
 template<class Node, std::size_t MaxPointers>
 void HpSlot<Node, MaxPointers>::clearAll() noexcept {
-    // 遍历数组，清空所有指针
+    // 遍历数组，清空所有指针（包括溢出块）
     for (auto& hp_atomic : hazard_ptrs_) {
         hp_atomic.store(nullptr, std::memory_order_release);
     }
+    for (OverflowBlock* b = overflow_head_.load(std::memory_order_relaxed); b;
+         b = b->next.load(std::memory_order_relaxed)) {
+        for (auto& hp_atomic : b->ptrs) {
+            hp_atomic.store(nullptr, std::memory_order_release);
+        }
+    }
 }
 
 
@@ -88,7 +271,7 @@ void HpSlot<Node, MaxPointers>::clearAll() noexcept {
 
 
 template<class Node, std::size_t MaxPointers>
-void HpSlot<Node, MaxPointers>::pushRetired(Node* n) noexcept {
+std::size_t HpSlot<Node, MaxPointers>::pushRetired(Node* n) noexcept {
     // 1. 强制转换为基类指针
     // 要求：Node 必须继承自 GCHook
     GCHook* hook = static_cast<GCHook*>(n);
@@ -101,11 +284,20 @@ void HpSlot<Node, MaxPointers>::pushRetired(Node* n) noexcept {
         old_head, hook, // 注意 retired_head 类型也应该是 atomic<GCHook*>
         std::memory_order_release,
         std::memory_order_relaxed));
+
+    return retired_count_.fetch_add(1, std::memory_order_relaxed) + 1;
 }
 
 template<class Node, std::size_t MaxPointers>
 Node* HpSlot<Node, MaxPointers>::drainAllRetired() noexcept {
-    return retired_head.exchange(nullptr, std::memory_order_acq_rel);
+    GCHook* head = retired_head.exchange(nullptr, std::memory_order_acq_rel);
+    retired_count_.store(0, std::memory_order_relaxed);
+    return static_cast<Node*>(head);
+}
+
+template<class Node, std::size_t MaxPointers>
+std::size_t HpSlot<Node, MaxPointers>::getRetiredCount() const noexcept {
+    return retired_count_.load(std::memory_order_relaxed);
 }
 
 
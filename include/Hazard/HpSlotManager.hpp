@@ -1,51 +1,84 @@
 #pragma once
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <vector>
-#include <mutex>
 #include "Hazard/HpSlot.hpp"
-#include "Tool/ShmMutexLock.hpp"
-#include "Hazard/HpSlotManagerDetail.hpp"
+#include "Hazard/HazardSnapshot.hpp"
 #include "AllocatorPolicies.hpp"
+#include "Tool/InstanceRegistry.hpp"
 
 
-template<class Node, std::size_t MaxPointers, class AllocPolicy = DefaultHeapPolicy>
+/**
+ * @brief 危险指针槽位登记表：只增不减的槽位块数组 + 每个槽位的占用标记。
+ *
+ * 槽位按块（kSlotsPerBlock 个、按缓存行对齐）分配，块指针放在定长数组里，
+ * 扫描者按下标顺序读取，不追指针、也不加锁；线程到达时先复用空闲槽位，
+ * 没有空闲槽位才用 fetch_add 领取新下标，需要时 CAS 安装新块。
+ * 线程退出时清空危险指针并归还槽位，退休链表留在槽位上。
+ *
+ * 每个线程在每个实例上各有一个槽位（线程本地缓存按实例编号区分），
+ * 同类型的多个实例互不干扰。
+ *
+ * Slot 默认是危险指针槽位 HpSlot；HazardEraOrganizer 换成发布纪元的 HeSlot，
+ * 登记、复用与退休链表的处理完全相同（snapshotHazardpoints 只适用于 HpSlot）。
+ */
+template<class Node, std::size_t MaxPointers, class AllocPolicy = DefaultHeapPolicy,
+         class Slot = HpSlot<Node, MaxPointers>>
 class HpSlotManager {
 public:
-    using SlotType = HpSlot<Node, MaxPointers>;
-    using SlotNode = HazardPointerDetail::SlotNode<Node, MaxPointers>;
+    using SlotType = Slot;
 
-    HpSlotManager() = default;
+    static constexpr std::size_t kSlotsPerBlock = 16;
+    static constexpr std::size_t kMaxBlocks     = 256;
+
+    HpSlotManager();
     ~HpSlotManager();
 
     HpSlotManager(const HpSlotManager&) = delete;
     HpSlotManager& operator=(const HpSlotManager&) = delete;
 
+    // 槽位全部用完时返回 nullptr
     SlotType* acquireTls();
+    // 当前被占用的槽位数
     std::size_t getSlotCount() const;
     void snapshotHazardpoints(std::vector<const Node*>& out) const;
+    // 收集到排好序的快照中（已 seal，可直接查找）
+    void snapshotHazardpoints(HazardSnapshot<Node>& out) const;
     std::size_t flushAllRetiredTo(std::atomic<Node*>& dst_head) noexcept;
+    // 只摘取空闲槽位（线程已退出）上遗留的退休链表
+    std::size_t flushOrphanedRetiredTo(std::atomic<Node*>& dst_head) noexcept;
 
 
     void retireNode(Node* n) noexcept;
     void retireList(Node* head) noexcept;
 
+    // 无锁遍历所有已分配的槽位（包括空闲槽位，其危险指针为空）
+    template<class Callable>
+    void forEachSlot(Callable func) const;
+
 private:
-    void unlinkUnlocked_(SlotType* s, SlotNode*& out_node_to_delete) noexcept;
-    void unregisterTls_();
-    SlotNode* head_{nullptr};
+    struct SlotBlock {
+        SlotType slots[kSlotsPerBlock];
+    };
+    // 分配器只保证 16 字节对齐：多分配一个缓存行，在其中手动对齐
+    struct BlockStorage {
+        alignas(16) unsigned char bytes[sizeof(SlotBlock) + alignof(SlotBlock)];
+    };
 
-    // 保护链表结构的互斥（跨进程鲁棒）
-    mutable ShmMutexLock shm_mutx_;
+    // 摘下 slot 的退休链表压入 dst_head，返回节点数
+    static std::size_t flushSlotTo_(SlotType& slot, std::atomic<Node*>& dst_head) noexcept;
 
-    inline static thread_local SlotType* tls_slot_ = nullptr;
-    // 仍然使用 Handler 来触发 onThreadExit
-    inline static thread_local HazardPointerDetail::ThreadExitHandler tls_exit_handler_{};
+    SlotType* acquireSlot_();
+    void releaseSlot_(SlotType* slot) noexcept;
+    // 确保第 block_index 块已经安装并返回该块；并发安装时败者释放自己的块，内存不足时返回 nullptr
+    SlotBlock* ensureBlock_(std::size_t block_index);
 
-    void linkHead_(SlotNode* n) noexcept {
-        n->next = head_;
-        head_   = n;
-    }
+    std::atomic<SlotBlock*>  blocks_[kMaxBlocks];
+    BlockStorage*            storages_[kMaxBlocks];   // 只在安装与析构时访问
+    std::atomic<std::size_t> next_index_{0};
+    std::atomic<std::size_t> slot_count_{0};
+    const std::uint64_t      instance_id_;
 };
 
 
@@ -1,152 +1,238 @@
 // HpSlotManager_impl.hpp
 #pragma once
-#include <iostream>
-#include <vector>
-#include <thread>
+#include <memory>
 #include <new>
+#include <vector>
 
 
 // ====================== 模板成员实现 ======================
 
-template<class Node, std::size_t MaxPointers, class AllocPolicy>
-HpSlotManager<Node, MaxPointers, AllocPolicy>::~HpSlotManager() {
-    SlotNode* current = head_;
-    while (current) {
-        SlotNode* next = current->next;
-        AllocPolicy::deallocate(current->slot);
-        AllocPolicy::deallocate(current);
-        current = next;
+template<class Node, std::size_t MaxPointers, class AllocPolicy, class Slot>
+HpSlotManager<Node, MaxPointers, AllocPolicy, Slot>::HpSlotManager()
+    : instance_id_(InstanceRegistry::registerInstance()) {
+    for (std::size_t b = 0; b < kMaxBlocks; ++b) {
+        blocks_[b].store(nullptr, std::memory_order_relaxed);
+        storages_[b] = nullptr;
     }
+}
+
+template<class Node, std::size_t MaxPointers, class AllocPolicy, class Slot>
+HpSlotManager<Node, MaxPointers, AllocPolicy, Slot>::~HpSlotManager() {
+    // 此后退出的线程不会再访问本实例
+    InstanceRegistry::unregisterInstance(instance_id_);
 
-    if (tls_slot_ != nullptr) {
-        // 通过直接清空 on_exit，我们阻止了在程序退出后期对悬垂指针的访问。
-        tls_exit_handler_.on_exit = nullptr;
-        tls_slot_ = nullptr; // 逻辑上也清空槽位指针
+    for (std::size_t b = 0; b < kMaxBlocks; ++b) {
+        SlotBlock* block = blocks_[b].load(std::memory_order_acquire);
+        if (block) {
+            for (SlotType& slot : block->slots) {
+                slot.template freeOverflow<AllocPolicy>();
+            }
+            block->~SlotBlock();
+            AllocPolicy::deallocate(storages_[b]);
+        }
     }
 }
 
 
+template<class Node, std::size_t MaxPointers, class AllocPolicy, class Slot>
+auto HpSlotManager<Node, MaxPointers, AllocPolicy, Slot>::acquireTls() -> SlotType* {
+    // 同一线程在每个实例中各持有一个槽位
+    thread_local InstanceLocalCache<HpSlotManager, SlotType*> local_slots(
+        [](HpSlotManager* manager, SlotType*& slot) { manager->releaseSlot_(slot); });
+
+    if (SlotType** cached = local_slots.find(this, instance_id_)) {
+        return *cached;
+    }
+    SlotType* slot = acquireSlot_();
+    if (!slot) {
+        return nullptr;
+    }
+    local_slots.insert(this, instance_id_, slot);
+    return slot;
+}
+
 
-template<class Node, std::size_t MaxPointers, class AllocPolicy>
-auto HpSlotManager<Node, MaxPointers, AllocPolicy>::acquireTls() -> SlotType* {
-    if (tls_slot_ == nullptr) {
-        tls_exit_handler_.on_exit = [this]() { this->unregisterTls_(); };
+template<class Node, std::size_t MaxPointers, class AllocPolicy, class Slot>
+auto HpSlotManager<Node, MaxPointers, AllocPolicy, Slot>::acquireSlot_() -> SlotType* {
+    constexpr std::size_t kCapacity = kSlotsPerBlock * kMaxBlocks;
 
-        auto* slot = AllocPolicy::template allocate<SlotType>();
-        auto* node = AllocPolicy::template allocate<SlotNode>();
-        node->slot = slot;
+    // 1. 先复用已退出线程归还的槽位
+    std::size_t used = next_index_.load(std::memory_order_acquire);
+    if (used > kCapacity) used = kCapacity;
+    for (std::size_t i = 0; i < used; ++i) {
+        SlotBlock* block = blocks_[i / kSlotsPerBlock].load(std::memory_order_acquire);
+        if (!block) {
+            i += kSlotsPerBlock - 1 - i % kSlotsPerBlock;   // 该块尚未安装，跳到下一块
+            continue;
+        }
+        SlotType& slot = block->slots[i % kSlotsPerBlock];
+        if (slot.tryAcquire()) {
+            slot_count_.fetch_add(1, std::memory_order_relaxed);
+            return &slot;
+        }
+    }
 
-        {
-            std::lock_guard<ShmMutexLock> lock(shm_mutx_);
-            node->next = head_;
-            head_ = node;
+    // 2. 没有空闲槽位：领取新下标，必要时安装新块。
+    //    下标对应的槽位可能先被其他线程的复用扫描抢走，此时再领一个
+    for (;;) {
+        const std::size_t index = next_index_.fetch_add(1, std::memory_order_acq_rel);
+        if (index >= kCapacity) {
+            return nullptr;
+        }
+        SlotBlock* block = ensureBlock_(index / kSlotsPerBlock);
+        if (!block) {
+            return nullptr;   // 内存不足；这个下标在块装好后由复用扫描找回
         }
-        tls_slot_ = slot;
+        SlotType& slot = block->slots[index % kSlotsPerBlock];
+        if (slot.tryAcquire()) {
+            slot_count_.fetch_add(1, std::memory_order_relaxed);
+            return &slot;
+        }
+    }
+}
+
+template<class Node, std::size_t MaxPointers, class AllocPolicy, class Slot>
+void HpSlotManager<Node, MaxPointers, AllocPolicy, Slot>::releaseSlot_(SlotType* slot) noexcept {
+    slot->release();
+    slot_count_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+template<class Node, std::size_t MaxPointers, class AllocPolicy, class Slot>
+auto HpSlotManager<Node, MaxPointers, AllocPolicy, Slot>::ensureBlock_(std::size_t block_index) -> SlotBlock* {
+    SlotBlock* block = blocks_[block_index].load(std::memory_order_acquire);
+    if (block) {
+        return block;
+    }
+
+    BlockStorage* storage = AllocPolicy::template allocate<BlockStorage>();
+    if (!storage) {
+        return nullptr;
+    }
+    void*         aligned = storage->bytes;
+    std::size_t   space   = sizeof(storage->bytes);
+    std::align(alignof(SlotBlock), sizeof(SlotBlock), aligned, space);
+    SlotBlock* fresh = ::new (aligned) SlotBlock();
+
+    // release 与扫描者的 acquire 配对：看到块指针就能看到构造好的槽位
+    if (blocks_[block_index].compare_exchange_strong(block, fresh,
+                                                     std::memory_order_acq_rel,
+                                                     std::memory_order_acquire)) {
+        storages_[block_index] = storage;
+        return fresh;
     }
-    return tls_slot_;
+
+    // 其他线程抢先安装了这一块
+    fresh->~SlotBlock();
+    AllocPolicy::deallocate(storage);
+    return block;
 }
 
 
-template<class Node, std::size_t MaxPointers, class AllocPolicy>
-void HpSlotManager<Node, MaxPointers, AllocPolicy>::unregisterTls_() {
-    SlotType* slot_to_delete = tls_slot_;
-    if (!slot_to_delete) return;
+template<class Node, std::size_t MaxPointers, class AllocPolicy, class Slot>
+template<class Callable>
+void HpSlotManager<Node, MaxPointers, AllocPolicy, Slot>::forEachSlot(Callable func) const {
+    // 只遍历领取过的下标范围；尚未安装的块里不可能有已发布的危险指针
+    std::size_t used = next_index_.load(std::memory_order_acquire);
+    if (used > kSlotsPerBlock * kMaxBlocks) used = kSlotsPerBlock * kMaxBlocks;
+    const std::size_t block_count = (used + kSlotsPerBlock - 1) / kSlotsPerBlock;
 
-    SlotNode* node_to_delete = nullptr;
-    {
-        std::lock_guard<ShmMutexLock> lock(shm_mutx_);
-        unlinkUnlocked_(slot_to_delete, node_to_delete);
+    for (std::size_t b = 0; b < block_count; ++b) {
+        SlotBlock* block = blocks_[b].load(std::memory_order_acquire);
+        if (!block) continue;
+        for (std::size_t i = 0; i < kSlotsPerBlock; ++i) {
+            func(block->slots[i]);
+        }
     }
-    
-    // 在锁外执行释放
-    AllocPolicy::deallocate(node_to_delete);
-    AllocPolicy::deallocate(slot_to_delete);
-    
-    tls_slot_ = nullptr;
 }
 
 
-template<class Node, std::size_t MaxPointers, class AllocPolicy>
-std::size_t HpSlotManager<Node, MaxPointers, AllocPolicy>::getSlotCount() const {
-    std::size_t n = 0;
-    std::lock_guard<ShmMutexLock> lk(shm_mutx_);
-    for (SlotNode* p = head_; p; p = p->next) ++n;
-    return n;
+template<class Node, std::size_t MaxPointers, class AllocPolicy, class Slot>
+std::size_t HpSlotManager<Node, MaxPointers, AllocPolicy, Slot>::getSlotCount() const {
+    // 计数随占用/归还维护，读取不需要遍历槽位
+    return slot_count_.load(std::memory_order_relaxed);
 }
 
 
-template<class Node, std::size_t MaxPointers, class AllocPolicy>
-void HpSlotManager<Node, MaxPointers, AllocPolicy>::snapshotHazardpoints(std::vector<const Node*>& out) const {
+template<class Node, std::size_t MaxPointers, class AllocPolicy, class Slot>
+void HpSlotManager<Node, MaxPointers, AllocPolicy, Slot>::snapshotHazardpoints(std::vector<const Node*>& out) const {
     out.clear();
-    std::lock_guard<ShmMutexLock> lock(shm_mutx_);
-    for (SlotNode* p = head_; p; p = p->next) {
-        SlotType* slot = p->slot;
-        // 使用 HpSlot 的公共接口进行扫描
-        for (std::size_t i = 0; i < slot->getHazardPointerCount(); ++i) {
-            const auto& hp_atomic = slot->getHazardPointerAt(i);
-            const Node* ptr = hp_atomic.load(std::memory_order_acquire);
-            if (ptr) {
-                out.push_back(ptr);
-            }
-        }
-    }
+    forEachSlot([&out](SlotType& slot) {
+        slot.forEachHazard([&out](const Node* ptr) { out.push_back(ptr); });
+    });
+}
+
+
+template<class Node, std::size_t MaxPointers, class AllocPolicy, class Slot>
+void HpSlotManager<Node, MaxPointers, AllocPolicy, Slot>::snapshotHazardpoints(HazardSnapshot<Node>& out) const {
+    out.clear();
+    forEachSlot([&out](SlotType& slot) {
+        slot.forEachHazard([&out](const Node* ptr) { out.push(ptr); });
+    });
+    out.seal();
 }
 
 
 // ====================== 新增：flushAllRetiredTo ======================
-template<class Node, std::size_t MaxPointers, class AllocPolicy>
-std::size_t HpSlotManager<Node, MaxPointers, AllocPolicy>::flushAllRetiredTo(std::atomic<Node*>& dst_head) noexcept {
-    std::vector<SlotType*> slots;
-    {
-        std::lock_guard<ShmMutexLock> lock(shm_mutx_);
-        for (SlotNode* p = head_; p; p = p->next) {
-            slots.push_back(p->slot);
-        }
-    }
+template<class Node, std::size_t MaxPointers, class AllocPolicy, class Slot>
+std::size_t HpSlotManager<Node, MaxPointers, AllocPolicy, Slot>::flushAllRetiredTo(std::atomic<Node*>& dst_head) noexcept {
+    std::size_t total_flushed = 0;
+    // 空闲槽位上也可能留有已退出线程的退休链表，一并摘下
+    forEachSlot([&](SlotType& slot) {
+        total_flushed += flushSlotTo_(slot, dst_head);
+    });
+    return total_flushed;
+}
 
-    size_t total_flushed = 0;
-    for (SlotType* slot : slots) {
-        // [修改 1] getRetiredListHead() 现在返回 Atomic<GCHook*>，所以取出的是 GCHook*
-        GCHook* hook_ptr = slot->getRetiredListHead().exchange(nullptr, std::memory_order_acq_rel);
-        
-        if (!hook_ptr) continue;
-        
-        // [修改 2] 将 GCHook* 安全转回 Node* (前提是 Node 继承自 GCHook)
-        Node* retired_list = static_cast<Node*>(hook_ptr);
-        
-        Node* tail = retired_list;
-        size_t count = 1;
-
-        // [修改 3] 遍历链表寻找尾部时，必须走 gc_next，绝对不能碰 next (那是栈逻辑用的)
-        while (tail->gc_next) {
-            // gc_next 是 GCHook* 类型，转回 Node* 继续遍历
-            tail = static_cast<Node*>(tail->gc_next);
-            count++;
+template<class Node, std::size_t MaxPointers, class AllocPolicy, class Slot>
+std::size_t HpSlotManager<Node, MaxPointers, AllocPolicy, Slot>::flushOrphanedRetiredTo(std::atomic<Node*>& dst_head) noexcept {
+    std::size_t total_flushed = 0;
+    forEachSlot([&](SlotType& slot) {
+        // 先读链表头，跳过大多数空槽位；槽位此时被新线程占用也无妨，exchange 保证链表只被一方摘走
+        if (!slot.isInUse() &&
+            slot.getRetiredListHead().load(std::memory_order_relaxed) != nullptr) {
+            total_flushed += flushSlotTo_(slot, dst_head);
         }
+    });
+    return total_flushed;
+}
+
+template<class Node, std::size_t MaxPointers, class AllocPolicy, class Slot>
+std::size_t HpSlotManager<Node, MaxPointers, AllocPolicy, Slot>::flushSlotTo_(SlotType& slot, std::atomic<Node*>& dst_head) noexcept {
+    // 摘下整条退休链表，同时清零槽位的退休计数
+    Node* retired_list = slot.drainAllRetired();
+    if (!retired_list) return 0;
+
+    Node* tail = retired_list;
+    std::size_t count = 1;
 
-        Node* old_head = dst_head.load(std::memory_order_relaxed);
-        do {
-            // [修改 4] 链接旧链表头时，修改的是 gc_next
-            // old_head 是 Node*，赋值给 gc_next (GCHook*) 是安全的隐式转换
-            tail->gc_next = old_head;
-            
-        } while (!dst_head.compare_exchange_weak(old_head, retired_list, std::memory_order_release, std::memory_order_relaxed));
-        
-        total_flushed += count;
+    // [修改 3] 遍历链表寻找尾部时，必须走 gc_next，绝对不能碰 next (那是栈逻辑用的)
+    while (tail->gc_next) {
+        // gc_next 是 GCHook* 类型，转回 Node* 继续遍历
+        tail = static_cast<Node*>(tail->gc_next);
+        count++;
     }
-    return total_flushed;
+
+    Node* old_head = dst_head.load(std::memory_order_relaxed);
+    do {
+        // [修改 4] 链接旧链表头时，修改的是 gc_next
+        // old_head 是 Node*，赋值给 gc_next (GCHook*) 是安全的隐式转换
+        tail->gc_next = old_head;
+
+    } while (!dst_head.compare_exchange_weak(old_head, retired_list, std::memory_order_release, std::memory_order_relaxed));
+
+    return count;
 }
 
 
-template<class Node, std::size_t MaxPointers, class AllocPolicy>
-void HpSlotManager<Node, MaxPointers, AllocPolicy>::retireNode(Node* n) noexcept {
+template<class Node, std::size_t MaxPointers, class AllocPolicy, class Slot>
+void HpSlotManager<Node, MaxPointers, AllocPolicy, Slot>::retireNode(Node* n) noexcept {
     if (n) {
         acquireTls()->pushRetired(n);
     }
 }
 
-template<class Node, std::size_t MaxPointers, class AllocPolicy>
-void HpSlotManager<Node, MaxPointers, AllocPolicy>::retireList(Node* head) noexcept {
+template<class Node, std::size_t MaxPointers, class AllocPolicy, class Slot>
+void HpSlotManager<Node, MaxPointers, AllocPolicy, Slot>::retireList(Node* head) noexcept {
     if (!head) return;
     SlotType* s = acquireTls();
     Node* current = head;
@@ -156,17 +242,3 @@ void HpSlotManager<Node, MaxPointers, AllocPolicy>::retireList(Node* head) noexc
         current = next;
     }
 }
-
-template<class Node, std::size_t MaxPointers, class AllocPolicy>
-void HpSlotManager<Node, MaxPointers, AllocPolicy>::unlinkUnlocked_(SlotType* s, SlotNode*& out_node_to_delete) noexcept {
-    SlotNode** current_ptr = &head_;
-    while (*current_ptr) {
-        if ((*current_ptr)->slot == s) {
-            out_node_to_delete = *current_ptr;
-            *current_ptr = (*current_ptr)->next;
-            return;
-        }
-        current_ptr = &((*current_ptr)->next);
-    }
-}
-
@@ -0,0 +1,309 @@
+// include/Hazard/ShmHazardDomain.hpp
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <sys/types.h>
+#include <type_traits>
+
+#include "Hazard/GCHook.hpp"
+#include "Tool/PidSlotTable.hpp"
+#include "Tool/RetireBudget.hpp"
+
+
+/**
+ * @brief 放在共享内存中的危险指针域：固定大小的槽位表 + 孤儿退休链表。
+ *
+ * 每个线程（不论属于哪个进程）占用一个槽位，槽位登记持有者的 PID。
+ * 域里不保存任何进程相关的指针：危险指针和退休链表都以相对于域自身地址的偏移存储，
+ * 只要节点与域位于同一段共享内存中，各进程按自己的映射地址解码即可。
+ * 对象可以直接 placement new 到 ShmSegment / ThreadHeap 内存中。
+ *
+ * 进程崩溃时它的槽位会被其他进程发现并回收（见 PidSlotTable）：
+ * 危险指针被清空，退休链表转入孤儿链表，由任意进程代为释放。
+ *
+ * 退休链表借用 GCHook::gc_next 存放偏移：节点在链表中时不能被解引用为指针。
+ * 域绑定节点类型 Node：一个进程退休的节点可能经孤儿链表由另一个进程按 Node 释放、
+ * 按 sizeof(Node) 计量，所以挂接到同一个域的 ShmHazardOrganizer 必须管理同一种节点。
+ * 退休内存预算也放在域里，由所有进程共同计量，一个进程的慢读者会让所有进程的 retire 都看到超出预算。
+ * 进程本地的一侧见 ShmHazardOrganizer。
+ */
+template <class Node, std::size_t MaxPointers>
+class ShmHazardDomain {
+public:
+    static_assert(std::is_base_of<GCHook, Node>::value,
+                  "ShmHazardDomain only holds GCHook-derived nodes.");
+
+    using NodeType = Node;
+
+    static constexpr std::size_t kMaxSlots    = 128;
+    static constexpr std::int32_t kInvalidSlot = -1;
+
+    // 0 表示空指针
+    using Offset = std::int64_t;
+
+    ShmHazardDomain() noexcept;
+    ~ShmHazardDomain() = default;
+
+    ShmHazardDomain(const ShmHazardDomain&) = delete;
+    ShmHazardDomain& operator=(const ShmHazardDomain&) = delete;
+    ShmHazardDomain(ShmHazardDomain&&) = delete;
+    ShmHazardDomain& operator=(ShmHazardDomain&&) = delete;
+
+    // --- 槽位登记 ---
+    // 为 pid 占用一个空闲槽位；没有空槽时先回收已死进程的槽位，仍然没有则返回 kInvalidSlot
+    std::int32_t acquireSlot(pid_t pid) noexcept;
+    // 清空危险指针后归还；退休链表留在槽位上，由 adoptOrphans 接手
+    void releaseSlot(std::int32_t index) noexcept;
+
+    // 回收所有持有者已经退出的槽位，返回回收的数量
+    std::size_t reapDeadSlots() noexcept;
+
+    pid_t getSlotOwner(std::int32_t index) const noexcept;
+    std::size_t getUsedSlotCount() const noexcept;
+
+    // --- 危险指针（只允许槽位持有者调用） ---
+    void protect(std::int32_t index, std::size_t hp, const void* p) noexcept;
+    void clear(std::int32_t index, std::size_t hp) noexcept;
+    void clearAll(std::int32_t index) noexcept;
+
+    // 按本进程的映射地址回调每个非空危险指针（不区分持有者是否存活）
+    template <class Callable>
+    void forEachHazard(Callable func) const;
+
+    // --- 退休链表 ---
+    // 压入槽位自己的退休链表，返回压入后的计数
+    std::size_t pushRetired(std::int32_t index, GCHook* node) noexcept;
+    // 摘下槽位的退休链表，gc_next 已改回本进程指针
+    GCHook* takeRetired(std::int32_t index) noexcept;
+    // 把 gc_next 串起来的链整段压入孤儿链表
+    void pushOrphans(GCHook* head) noexcept;
+    // 把空闲槽位上遗留的退休链表并入孤儿链表，再整体摘下（gc_next 已改回本进程指针）
+    GCHook* adoptOrphans() noexcept;
+    // 摘下所有槽位（包括仍在使用的）与孤儿链表上的退休节点；可以与持有者的 pushRetired 并发，
+    // 节点仍可能受保护，释放前必须扫描危险指针
+    GCHook* takeAllRetired() noexcept;
+
+    // 整个域（所有进程）共用的退休内存预算与计量
+    RetireBudget& getRetireBudget() noexcept { return retire_budget_; }
+    const RetireBudget& getRetireBudget() const noexcept { return retire_budget_; }
+
+private:
+    struct Slot {
+        std::atomic<Offset>       hazards[MaxPointers];
+        std::atomic<Offset>       retired_head;
+        std::atomic<std::size_t>  retired_count;
+    };
+    using SlotTable = PidSlotTable<Slot, kMaxSlots>;
+
+    Offset toOffset_(const void* p) const noexcept {
+        return p ? static_cast<Offset>(reinterpret_cast<std::intptr_t>(p) -
+                                       reinterpret_cast<std::intptr_t>(this))
+                 : 0;
+    }
+    template <class T>
+    T* fromOffset_(Offset off) const noexcept {
+        return off ? reinterpret_cast<T*>(reinterpret_cast<std::intptr_t>(this) + off) : nullptr;
+    }
+
+    // 把本进程指针串起来的链改写成偏移链，返回链头偏移，tail 输出链尾
+    Offset encodeChain_(GCHook* head, GCHook*& tail) const noexcept;
+    // 把偏移链改写回本进程指针链
+    GCHook* decodeChain_(Offset head) const noexcept;
+    // 把偏移链 [head, tail] 压入 list
+    void pushEncoded_(std::atomic<Offset>& list, Offset head, GCHook* tail) noexcept;
+
+    // 回收死进程的槽位：清空危险指针、把退休链表转入孤儿链表
+    void reapSlot_(Slot& slot) noexcept;
+
+    alignas(64) std::atomic<Offset> orphan_head_;
+    SlotTable slots_;
+    RetireBudget retire_budget_;
+};
+
+
+template <class Node, std::size_t MaxPointers>
+ShmHazardDomain<Node, MaxPointers>::ShmHazardDomain() noexcept {
+    for (std::size_t i = 0; i < kMaxSlots; ++i) {
+        Slot& slot = slots_.getPayload(static_cast<std::int32_t>(i));
+        for (auto& hp : slot.hazards) {
+            hp.store(0, std::memory_order_relaxed);
+        }
+        slot.retired_head.store(0, std::memory_order_relaxed);
+        slot.retired_count.store(0, std::memory_order_relaxed);
+    }
+    // 发布初始化结果
+    orphan_head_.store(0, std::memory_order_release);
+}
+
+template <class Node, std::size_t MaxPointers>
+std::int32_t ShmHazardDomain<Node, MaxPointers>::acquireSlot(pid_t pid) noexcept {
+    return slots_.acquire(pid, [this](Slot& slot) { reapSlot_(slot); });
+}
+
+template <class Node, std::size_t MaxPointers>
+void ShmHazardDomain<Node, MaxPointers>::releaseSlot(std::int32_t index) noexcept {
+    if (index < 0 || static_cast<std::size_t>(index) >= kMaxSlots) {
+        return;
+    }
+    clearAll(index);
+    slots_.release(index);
+}
+
+template <class Node, std::size_t MaxPointers>
+std::size_t ShmHazardDomain<Node, MaxPointers>::reapDeadSlots() noexcept {
+    return slots_.reapDead([this](Slot& slot) { reapSlot_(slot); });
+}
+
+template <class Node, std::size_t MaxPointers>
+pid_t ShmHazardDomain<Node, MaxPointers>::getSlotOwner(std::int32_t index) const noexcept {
+    return slots_.getOwner(index);
+}
+
+template <class Node, std::size_t MaxPointers>
+std::size_t ShmHazardDomain<Node, MaxPointers>::getUsedSlotCount() const noexcept {
+    return slots_.getUsedCount();
+}
+
+template <class Node, std::size_t MaxPointers>
+void ShmHazardDomain<Node, MaxPointers>::protect(std::int32_t index, std::size_t hp, const void* p) noexcept {
+    slots_.getPayload(index).hazards[hp].store(toOffset_(p), std::memory_order_release);
+}
+
+template <class Node, std::size_t MaxPointers>
+void ShmHazardDomain<Node, MaxPointers>::clear(std::int32_t index, std::size_t hp) noexcept {
+    slots_.getPayload(index).hazards[hp].store(0, std::memory_order_release);
+}
+
+template <class Node, std::size_t MaxPointers>
+void ShmHazardDomain<Node, MaxPointers>::clearAll(std::int32_t index) noexcept {
+    for (auto& hp : slots_.getPayload(index).hazards) {
+        hp.store(0, std::memory_order_release);
+    }
+}
+
+template <class Node, std::size_t MaxPointers>
+template <class Callable>
+void ShmHazardDomain<Node, MaxPointers>::forEachHazard(Callable func) const {
+    for (std::size_t i = 0; i < kMaxSlots; ++i) {
+        for (const auto& hp : slots_.getPayload(static_cast<std::int32_t>(i)).hazards) {
+            const Offset off = hp.load(std::memory_order_acquire);
+            if (off) {
+                func(fromOffset_<const void>(off));
+            }
+        }
+    }
+}
+
+template <class Node, std::size_t MaxPointers>
+std::size_t ShmHazardDomain<Node, MaxPointers>::pushRetired(std::int32_t index, GCHook* node) noexcept {
+    Slot& slot = slots_.getPayload(index);
+    node->gc_next = nullptr;
+    GCHook* tail = nullptr;
+    const Offset head = encodeChain_(node, tail);
+    pushEncoded_(slot.retired_head, head, tail);
+    return slot.retired_count.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+template <class Node, std::size_t MaxPointers>
+GCHook* ShmHazardDomain<Node, MaxPointers>::takeRetired(std::int32_t index) noexcept {
+    Slot& slot = slots_.getPayload(index);
+    const Offset head = slot.retired_head.exchange(0, std::memory_order_acq_rel);
+    slot.retired_count.store(0, std::memory_order_relaxed);
+    return decodeChain_(head);
+}
+
+template <class Node, std::size_t MaxPointers>
+void ShmHazardDomain<Node, MaxPointers>::pushOrphans(GCHook* head) noexcept {
+    if (!head) return;
+    GCHook* tail = nullptr;
+    const Offset encoded = encodeChain_(head, tail);
+    pushEncoded_(orphan_head_, encoded, tail);
+}
+
+template <class Node, std::size_t MaxPointers>
+GCHook* ShmHazardDomain<Node, MaxPointers>::adoptOrphans() noexcept {
+    GCHook* adopted = decodeChain_(orphan_head_.exchange(0, std::memory_order_acq_rel));
+    for (std::size_t i = 0; i < kMaxSlots; ++i) {
+        const auto index = static_cast<std::int32_t>(i);
+        Slot& slot = slots_.getPayload(index);
+        // 槽位此时被新线程占用也无妨，exchange 保证链表只被一方摘走
+        if (slots_.getOwner(index) != 0 ||
+            slot.retired_head.load(std::memory_order_relaxed) == 0) {
+            continue;
+        }
+        GCHook* list = decodeChain_(slot.retired_head.exchange(0, std::memory_order_acq_rel));
+        slot.retired_count.store(0, std::memory_order_relaxed);
+        while (list) {
+            GCHook* next = list->gc_next;
+            list->gc_next = adopted;
+            adopted = list;
+            list = next;
+        }
+    }
+    return adopted;
+}
+
+template <class Node, std::size_t MaxPointers>
+GCHook* ShmHazardDomain<Node, MaxPointers>::takeAllRetired() noexcept {
+    GCHook* all = decodeChain_(orphan_head_.exchange(0, std::memory_order_acq_rel));
+    for (std::size_t i = 0; i < kMaxSlots; ++i) {
+        GCHook* list = takeRetired(static_cast<std::int32_t>(i));
+        while (list) {
+            GCHook* next = list->gc_next;
+            list->gc_next = all;
+            all = list;
+            list = next;
+        }
+    }
+    return all;
+}
+
+template <class Node, std::size_t MaxPointers>
+auto ShmHazardDomain<Node, MaxPointers>::encodeChain_(GCHook* head, GCHook*& tail) const noexcept -> Offset {
+    tail = head;
+    while (tail) {
+        GCHook* next = tail->gc_next;
+        tail->gc_next = reinterpret_cast<GCHook*>(toOffset_(next));
+        if (!next) break;
+        tail = next;
+    }
+    return toOffset_(head);
+}
+
+template <class Node, std::size_t MaxPointers>
+GCHook* ShmHazardDomain<Node, MaxPointers>::decodeChain_(Offset head) const noexcept {
+    GCHook* first = fromOffset_<GCHook>(head);
+    for (GCHook* p = first; p; p = p->gc_next) {
+        p->gc_next = fromOffset_<GCHook>(reinterpret_cast<Offset>(p->gc_next));
+    }
+    return first;
+}
+
+template <class Node, std::size_t MaxPointers>
+void ShmHazardDomain<Node, MaxPointers>::pushEncoded_(std::atomic<Offset>& list, Offset head, GCHook* tail) noexcept {
+    // 只压入、摘取整条链，不存在 ABA
+    Offset old_head = list.load(std::memory_order_relaxed);
+    do {
+        tail->gc_next = reinterpret_cast<GCHook*>(old_head);
+    } while (!list.compare_exchange_weak(old_head, head,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed));
+}
+
+template <class Node, std::size_t MaxPointers>
+void ShmHazardDomain<Node, MaxPointers>::reapSlot_(Slot& slot) noexcept {
+    for (auto& hp : slot.hazards) {
+        hp.store(0, std::memory_order_relaxed);
+    }
+    const Offset retired = slot.retired_head.exchange(0, std::memory_order_acquire);
+    slot.retired_count.store(0, std::memory_order_relaxed);
+    if (retired) {
+        GCHook* tail = fromOffset_<GCHook>(retired);
+        while (tail->gc_next) {
+            tail = fromOffset_<GCHook>(reinterpret_cast<Offset>(tail->gc_next));
+        }
+        pushEncoded_(orphan_head_, retired, tail);
+    }
+}
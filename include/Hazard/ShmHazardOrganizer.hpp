@@ -0,0 +1,324 @@
+// include/Hazard/ShmHazardOrganizer.hpp
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <unistd.h>
+
+#include "Hazard/AllocatorPolicies.hpp"
+#include "Hazard/GCHook.hpp"
+#include "Hazard/HazardSnapshot.hpp"
+#include "Hazard/ShmHazardDomain.hpp"
+#include "Tool/AsymmetricFence.hpp"
+#include "Tool/InstanceRegistry.hpp"
+
+
+/**
+ * @brief 挂接到共享内存 ShmHazardDomain 上的进程本地危险指针管理器，
+ *        接口与 HazardPointerOrganizer 相同，可直接作为 LockFreeStack / LockFreeQueue 的 Organizer。
+ *
+ * 每个进程各自持有一个实例：线程第一次使用时在域里占用一个登记了本进程 PID 的槽位，
+ * 线程退出或管理器析构时归还。扫描读取所有进程的危险指针，
+ * 因此一个进程退休的节点只有在所有进程都不再保护它之后才会释放。
+ *
+ * 退休节点留在域里（以偏移串成链表），可以由任何进程释放：
+ * 进程崩溃后，collect 发现它的槽位已经失效，清空其危险指针并接手它的退休链表。
+ * 释放时调用 AllocPolicy::deallocate（经 GCHook 的虚析构），
+ * 所以各进程必须运行同一份映像（fork 出的子进程），分配器也必须是共享内存上的 ThreadHeap。
+ *
+ * 容器对象本身放在共享内存里时，它引用的管理器在每个进程中的地址必须相同：
+ * 在 fork 之前构造管理器即可，子进程使用自己的那一份副本。
+ *
+ * 只支持固定下标（protect/clear/clearAll），不支持 HazardPtrHolder 的动态下标。
+ */
+template <class Node, std::size_t MaxPointers, class AllocPolicy = DefaultHeapPolicy>
+class ShmHazardOrganizer {
+public:
+    static_assert(std::is_base_of<GCHook, Node>::value,
+                  "ShmHazardOrganizer only manages GCHook-derived nodes.");
+
+    using Domain = ShmHazardDomain<Node, MaxPointers>;
+
+    // 进程本地的槽位句柄，提供容器使用的 protect/clear/clearAll
+    class SlotHandle {
+    public:
+        void protect(std::size_t index, Node* p) noexcept { domain_->protect(index_, index, p); }
+        void clear(std::size_t index) noexcept { domain_->clear(index_, index); }
+        void clearAll() noexcept { domain_->clearAll(index_); }
+
+        std::int32_t getIndex() const noexcept { return index_; }
+
+    private:
+        friend class ShmHazardOrganizer;
+
+        Domain*      domain_{nullptr};
+        std::int32_t index_{Domain::kInvalidSlot};
+    };
+
+    using SlotType        = SlotHandle;
+    using NodeType        = Node;
+    using AllocPolicyType = AllocPolicy;
+
+    static constexpr std::size_t kMaxPointers = MaxPointers;
+
+    // 每个槽位的退休数超过 R = kScanFactor × 槽位上限 × MaxPointers（不低于 kMinScanThreshold）时自动扫描；
+    // 参与的线程数跨进程，无法廉价统计，所以按槽位上限计算
+    static constexpr std::size_t kScanFactor       = 2;
+    static constexpr std::size_t kMinScanThreshold = 64;
+
+public:
+    explicit ShmHazardOrganizer(Domain& domain);
+    // 归还本进程占用的槽位，再释放已经不受保护的节点；其余节点留在域中由其他进程回收
+    ~ShmHazardOrganizer();
+
+    ShmHazardOrganizer(const ShmHazardOrganizer&) = delete;
+    ShmHazardOrganizer& operator=(const ShmHazardOrganizer&) = delete;
+    ShmHazardOrganizer(ShmHazardOrganizer&&) = delete;
+    ShmHazardOrganizer& operator=(ShmHazardOrganizer&&) = delete;
+
+    // 与 HazardEraOrganizer 的容器接口对齐；危险指针不需要出生纪元
+    void stampBirth(GCHook*) noexcept {}
+
+    void retire(Node* node) noexcept;
+
+    static constexpr std::size_t getScanThreshold() noexcept {
+        return kScanFactor * Domain::kMaxSlots * MaxPointers < kMinScanThreshold
+                   ? kMinScanThreshold
+                   : kScanFactor * Domain::kMaxSlots * MaxPointers;
+    }
+
+    // 自动扫描累计释放的节点数（不含 collect / drainAllRetired 的返回值）
+    std::size_t getAutoReclaimedCount() const noexcept {
+        return auto_reclaimed_.load(std::memory_order_relaxed);
+    }
+
+    // 退休内存预算存放在域中，对所有进程生效（语义见 HazardPointerOrganizer::setRetireBudget；
+    // 超出预算时代为扫描域中所有槽位的退休链表，包括其他进程的）。
+    // 字节数按 sizeof(Node) 计量，可以据此限制慢读者占用的共享段空间
+    void setRetireBudget(std::size_t max_nodes, std::size_t max_bytes,
+                         std::chrono::nanoseconds max_backpressure = std::chrono::nanoseconds::zero()) noexcept {
+        domain_.getRetireBudget().setLimits(max_nodes, max_bytes, max_backpressure);
+    }
+    std::size_t getRetiredNodes() const noexcept { return domain_.getRetireBudget().getRetiredNodes(); }
+    std::size_t getRetiredBytes() const noexcept { return domain_.getRetireBudget().getRetiredBytes(); }
+    std::uint64_t getBudgetOverrunCount() const noexcept { return domain_.getRetireBudget().getOverrunCount(); }
+
+    // 扫描本线程自己的退休链表，回收已死进程的槽位，并代为处理孤儿节点。
+    // quota 只限制孤儿节点的释放数（0 表示不限）
+    std::size_t collect(std::size_t quota = 0) noexcept;
+
+    // 不检查危险指针，释放域中的全部退休节点；只在所有进程都不再访问容器时调用
+    std::size_t drainAllRetired() noexcept;
+
+    SlotType* acquireTlsSlot();
+
+    Domain& getDomain() noexcept { return domain_; }
+
+private:
+    void releaseSlot_(std::int32_t index) noexcept;
+    // 超出预算时调用：摘下域中所有槽位与孤儿链表上的退休节点统一扫描，仍受保护的转入孤儿链表
+    std::size_t helpReclaim_() noexcept;
+
+    // 只扫描本线程自己的退休链表，仍被保护的节点放回槽位
+    std::size_t scanLocal_(std::int32_t index) noexcept;
+    void snapshotHazards_(HazardSnapshot<Node>& snapshot) const;
+    // 释放 list 中未受保护的节点（最多 quota 个，0 表示不限），其余留在 list 中
+    static std::size_t reclaimUnprotected_(GCHook*& list, const HazardSnapshot<Node>& snapshot,
+                                           std::size_t quota = 0) noexcept;
+
+private:
+    Domain&             domain_;
+    const std::uint64_t instance_id_;
+    std::atomic<std::size_t> auto_reclaimed_{0};
+
+    // 本实例在域中占用的槽位，析构时统一归还
+    std::atomic<bool> owned_slots_[Domain::kMaxSlots];
+    SlotHandle        handles_[Domain::kMaxSlots];
+};
+
+
+template <class Node, std::size_t MaxPointers, class AllocPolicy>
+ShmHazardOrganizer<Node, MaxPointers, AllocPolicy>::ShmHazardOrganizer(Domain& domain)
+    : domain_(domain),
+      instance_id_(InstanceRegistry::registerInstance()) {
+    for (std::size_t i = 0; i < Domain::kMaxSlots; ++i) {
+        owned_slots_[i].store(false, std::memory_order_relaxed);
+        handles_[i].domain_ = &domain_;
+        handles_[i].index_  = static_cast<std::int32_t>(i);
+    }
+}
+
+template <class Node, std::size_t MaxPointers, class AllocPolicy>
+ShmHazardOrganizer<Node, MaxPointers, AllocPolicy>::~ShmHazardOrganizer() {
+    collect();
+    InstanceRegistry::unregisterInstance(instance_id_);
+    // fork 得到的副本里也记着父进程的槽位：只归还登记为本进程的
+    const pid_t self = ::getpid();
+    for (std::size_t i = 0; i < Domain::kMaxSlots; ++i) {
+        if (owned_slots_[i].load(std::memory_order_relaxed) &&
+            domain_.getSlotOwner(static_cast<std::int32_t>(i)) == self) {
+            releaseSlot_(static_cast<std::int32_t>(i));
+        }
+    }
+}
+
+template <class Node, std::size_t MaxPointers, class AllocPolicy>
+void ShmHazardOrganizer<Node, MaxPointers, AllocPolicy>::retire(Node* node) noexcept {
+    if (!node) return;
+    RetireBudget& budget = domain_.getRetireBudget();
+    budget.noteRetired(sizeof(Node));
+    SlotType* slot = acquireTlsSlot();
+    if (!slot) {
+        // 槽位已用完：直接放进孤儿链表，等待 collect
+        node->gc_next = nullptr;
+        domain_.pushOrphans(node);
+    } else if (domain_.pushRetired(slot->index_, node) >= getScanThreshold()) {
+        scanLocal_(slot->index_);
+    }
+    budget.enforce([this]() noexcept { helpReclaim_(); });
+}
+
+template <class Node, std::size_t MaxPointers, class AllocPolicy>
+std::size_t ShmHazardOrganizer<Node, MaxPointers, AllocPolicy>::collect(std::size_t quota) noexcept {
+    SlotType* slot = acquireTlsSlot();
+    GCHook* own = slot ? domain_.takeRetired(slot->index_) : nullptr;
+
+    // 先回收崩溃进程的槽位：它们的危险指针作废，退休链表转入孤儿链表
+    domain_.reapDeadSlots();
+    GCHook* orphans = domain_.adoptOrphans();
+    if (!own && !orphans) return 0;
+
+    // 摘链必须先于读取危险指针；heavy() 也覆盖其他已注册的进程
+    AsymmetricFence::heavy();
+    HazardSnapshot<Node>& snapshot = HazardSnapshot<Node>::local();
+    snapshotHazards_(snapshot);
+
+    std::size_t freed = 0;
+    if (own) {
+        freed += reclaimUnprotected_(own, snapshot);
+        while (own) {
+            GCHook* next = own->gc_next;
+            domain_.pushRetired(slot->index_, own);
+            own = next;
+        }
+    }
+    if (orphans) {
+        freed += reclaimUnprotected_(orphans, snapshot, quota);
+        domain_.pushOrphans(orphans);
+    }
+    domain_.getRetireBudget().noteReclaimed(freed);
+    return freed;
+}
+
+template <class Node, std::size_t MaxPointers, class AllocPolicy>
+std::size_t ShmHazardOrganizer<Node, MaxPointers, AllocPolicy>::helpReclaim_() noexcept {
+    domain_.reapDeadSlots();
+    GCHook* all = domain_.takeAllRetired();
+    if (!all) return 0;
+
+    AsymmetricFence::heavy();
+    HazardSnapshot<Node>& snapshot = HazardSnapshot<Node>::local();
+    snapshotHazards_(snapshot);
+
+    const std::size_t freed = reclaimUnprotected_(all, snapshot);
+    domain_.pushOrphans(all);
+    domain_.getRetireBudget().noteReclaimed(freed);
+    return freed;
+}
+
+template <class Node, std::size_t MaxPointers, class AllocPolicy>
+std::size_t ShmHazardOrganizer<Node, MaxPointers, AllocPolicy>::drainAllRetired() noexcept {
+    GCHook* list = domain_.takeAllRetired();
+    std::size_t freed = 0;
+    while (list) {
+        GCHook* next = list->gc_next;
+        AllocPolicy::deallocate(static_cast<Node*>(list));
+        list = next;
+        ++freed;
+    }
+    domain_.getRetireBudget().noteReclaimed(freed);
+    return freed;
+}
+
+template <class Node, std::size_t MaxPointers, class AllocPolicy>
+auto ShmHazardOrganizer<Node, MaxPointers, AllocPolicy>::acquireTlsSlot() -> SlotType* {
+    // 同一线程在每个实例中各持有一个槽位；fork 后的子进程会重新登记
+    thread_local InstanceLocalCache<ShmHazardOrganizer, SlotType*> local_slots(
+        [](ShmHazardOrganizer* organizer, SlotType*& slot) { organizer->releaseSlot_(slot->index_); });
+
+    if (SlotType** cached = local_slots.find(this, instance_id_)) {
+        return *cached;
+    }
+    const std::int32_t index = domain_.acquireSlot(::getpid());
+    if (index == Domain::kInvalidSlot) {
+        return nullptr;
+    }
+    owned_slots_[index].store(true, std::memory_order_release);
+    SlotType* slot = &handles_[index];
+    local_slots.insert(this, instance_id_, slot);
+    return slot;
+}
+
+template <class Node, std::size_t MaxPointers, class AllocPolicy>
+void ShmHazardOrganizer<Node, MaxPointers, AllocPolicy>::releaseSlot_(std::int32_t index) noexcept {
+    // 与析构竞争时只由一方归还
+    if (owned_slots_[index].exchange(false, std::memory_order_acq_rel)) {
+        domain_.releaseSlot(index);
+    }
+}
+
+template <class Node, std::size_t MaxPointers, class AllocPolicy>
+std::size_t ShmHazardOrganizer<Node, MaxPointers, AllocPolicy>::scanLocal_(std::int32_t index) noexcept {
+    GCHook* retired = domain_.takeRetired(index);
+    if (!retired) return 0;
+
+    AsymmetricFence::heavy();
+    HazardSnapshot<Node>& snapshot = HazardSnapshot<Node>::local();
+    snapshotHazards_(snapshot);
+
+    const std::size_t freed = reclaimUnprotected_(retired, snapshot);
+    while (retired) {
+        GCHook* next = retired->gc_next;
+        domain_.pushRetired(index, retired);
+        retired = next;
+    }
+    if (freed > 0) {
+        auto_reclaimed_.fetch_add(freed, std::memory_order_relaxed);
+        domain_.getRetireBudget().noteReclaimed(freed);
+    }
+    return freed;
+}
+
+template <class Node, std::size_t MaxPointers, class AllocPolicy>
+void ShmHazardOrganizer<Node, MaxPointers, AllocPolicy>::snapshotHazards_(HazardSnapshot<Node>& snapshot) const {
+    snapshot.clear();
+    domain_.forEachHazard([&snapshot](const void* p) {
+        snapshot.push(static_cast<const Node*>(static_cast<const GCHook*>(p)));
+    });
+    snapshot.seal();
+}
+
+template <class Node, std::size_t MaxPointers, class AllocPolicy>
+std::size_t ShmHazardOrganizer<Node, MaxPointers, AllocPolicy>::reclaimUnprotected_(
+        GCHook*& list, const HazardSnapshot<Node>& snapshot, std::size_t quota) noexcept {
+    std::size_t freed = 0;
+    GCHook* kept = nullptr;
+    GCHook* current = list;
+    while (current) {
+        GCHook* next = current->gc_next;
+        Node* node = static_cast<Node*>(current);
+        if ((quota == 0 || freed < quota) && !snapshot.contains(node)) {
+            AllocPolicy::deallocate(node);
+            ++freed;
+        } else {
+            current->gc_next = kept;
+            kept = current;
+        }
+        current = next;
+    }
+    list = kept;
+    return freed;
+}
@@ -8,7 +8,8 @@
 
 template <typename K,
           typename V,
-          typename KeyEqual = std::equal_to<K>>
+          typename KeyEqual = std::equal_to<K>,
+          typename Reclaimer = EBRManager>
 class LockFreeChain {
 public:
     using Node          = LockFreeHashMapNode<K, V>;
@@ -26,12 +27,12 @@ public:
     LockFreeChain(LockFreeChain&&)                 = delete;
     LockFreeChain& operator=(LockFreeChain&&)      = delete;
 
-    std::optional<V> find(const K& key, EBRManager& manager) const;
+    std::optional<V> find(const K& key, Reclaimer& manager) const;
 
     template <typename KeyType, typename ValueType>
-    bool insert(KeyType&& key, ValueType&& value, EBRManager& manager);
+    bool insert(KeyType&& key, ValueType&& value, Reclaimer& manager);
 
-    bool     remove(const K& key, EBRManager& manager);
+    bool     remove(const K& key, Reclaimer& manager);
     NodePtr  getHead() const;
 
 private:
@@ -40,7 +41,9 @@ private:
         NodePtr        curr_;     // 当前未标记节点（raw 指针）
     };
 
-    SearchResult search_(const K& key, EBRManager& manager) const;
+    SearchResult search_(const K& key, Reclaimer& manager) const;
+    // 读取槽位中会被解引用的节点指针（去标记）
+    static NodePtr loadProtected_(const AtomicNodePtr& slot, Reclaimer& manager);
 
 private:
     mutable AtomicNodePtr head_;  // 头结点槽位（packed: ptr+stamp）
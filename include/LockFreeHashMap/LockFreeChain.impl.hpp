@@ -8,12 +8,12 @@
 
 // --- 构造 / 析构 ---
 
-template <typename K, typename V, typename KeyEqual>
-LockFreeChain<K, V, KeyEqual>::LockFreeChain()
+template <typename K, typename V, typename KeyEqual, typename Reclaimer>
+LockFreeChain<K, V, KeyEqual, Reclaimer>::LockFreeChain()
     : head_(Packer::pack(nullptr, 0)), keyEqual_() {}
 
-template <typename K, typename V, typename KeyEqual>
-LockFreeChain<K, V, KeyEqual>::~LockFreeChain() {
+template <typename K, typename V, typename KeyEqual, typename Reclaimer>
+LockFreeChain<K, V, KeyEqual, Reclaimer>::~LockFreeChain() {
     NodePtr curr = Node::getPointer(head_);
     while (curr) {
         NodePtr next = Node::getPointer(curr->next);
@@ -23,16 +23,16 @@ LockFreeChain<K, V, KeyEqual>::~LockFreeChain() {
     }
 }
 
-template <typename K, typename V, typename KeyEqual>
-typename LockFreeChain<K, V, KeyEqual>::NodePtr
-LockFreeChain<K, V, KeyEqual>::getHead() const {
+template <typename K, typename V, typename KeyEqual, typename Reclaimer>
+typename LockFreeChain<K, V, KeyEqual, Reclaimer>::NodePtr
+LockFreeChain<K, V, KeyEqual, Reclaimer>::getHead() const {
     return Node::getPointer(head_);
 }
 
 // --- 查找 ---
 
-template <typename K, typename V, typename KeyEqual>
-std::optional<V> LockFreeChain<K, V, KeyEqual>::find(const K& key, EBRManager& manager) const {
+template <typename K, typename V, typename KeyEqual, typename Reclaimer>
+std::optional<V> LockFreeChain<K, V, KeyEqual, Reclaimer>::find(const K& key, Reclaimer& manager) const {
     SearchResult result = search_(key, manager);
     if (result.curr_ != nullptr && !Node::isMarked(result.curr_->next)) {
         return result.curr_->value;
@@ -42,11 +42,12 @@ std::optional<V> LockFreeChain<K, V, KeyEqual>::find(const K& key, EBRManager& m
 
 // --- 插入 ---
 
-template <typename K, typename V, typename KeyEqual>
+template <typename K, typename V, typename KeyEqual, typename Reclaimer>
 template <typename KeyType, typename ValueType>
-bool LockFreeChain<K, V, KeyEqual>::insert(KeyType&& key, ValueType&& value, EBRManager& manager) {
+bool LockFreeChain<K, V, KeyEqual, Reclaimer>::insert(KeyType&& key, ValueType&& value, Reclaimer& manager) {
     void*   raw_mem  = ThreadHeap::allocate(sizeof(Node));
     NodePtr new_node = new (raw_mem) Node(std::forward<KeyType>(key), std::forward<ValueType>(value));
+    ebr::stampBirth(manager, new_node);
 
     while (true) {
         SearchResult result = search_(key, manager);
@@ -79,8 +80,8 @@ bool LockFreeChain<K, V, KeyEqual>::insert(KeyType&& key, ValueType&& value, EBR
 
 // --- 删除 ---
 
-template <typename K, typename V, typename KeyEqual>
-bool LockFreeChain<K, V, KeyEqual>::remove(const K& key, EBRManager& manager) {
+template <typename K, typename V, typename KeyEqual, typename Reclaimer>
+bool LockFreeChain<K, V, KeyEqual, Reclaimer>::remove(const K& key, Reclaimer& manager) {
     while (true) {
         SearchResult result = search_(key, manager);
         if (result.curr_ == nullptr) {
@@ -119,15 +120,16 @@ bool LockFreeChain<K, V, KeyEqual>::remove(const K& key, EBRManager& manager) {
 
 // --- 私有：搜索并按需清理（带 EBR 保护） ---
 
-template <typename K, typename V, typename KeyEqual>
-typename LockFreeChain<K, V, KeyEqual>::SearchResult
-LockFreeChain<K, V, KeyEqual>::search_(const K& key, EBRManager& manager) const {
+template <typename K, typename V, typename KeyEqual, typename Reclaimer>
+typename LockFreeChain<K, V, KeyEqual, Reclaimer>::SearchResult
+LockFreeChain<K, V, KeyEqual, Reclaimer>::search_(const K& key, Reclaimer& manager) const {
 retry_search:
-    SearchResult result = { const_cast<AtomicNodePtr*>(&head_), Node::getPointer(head_) };
+    // 会被解引用的指针都经 ebr::load 读取（健壮模式下维护保留区间）
+    SearchResult result = { const_cast<AtomicNodePtr*>(&head_), loadProtected_(head_, manager) };
 
     while (result.curr_ != nullptr) {
         NodePtr curr_unmarked = result.curr_;
-        NodePtr next          = Node::getPointer(curr_unmarked->next);
+        NodePtr next          = loadProtected_(curr_unmarked->next, manager);
 
         // 如果当前节点已被标记：尝试物理摘除
         if (Node::isMarked(curr_unmarked->next)) {
@@ -157,3 +159,9 @@ retry_search:
     // 未找到
     return result;
 }
+
+template <typename K, typename V, typename KeyEqual, typename Reclaimer>
+typename LockFreeChain<K, V, KeyEqual, Reclaimer>::NodePtr
+LockFreeChain<K, V, KeyEqual, Reclaimer>::loadProtected_(const AtomicNodePtr& slot, Reclaimer& manager) {
+    return Node::getUnmarked(Node::Packer::unpackPtr(ebr::load(manager, slot)));
+}
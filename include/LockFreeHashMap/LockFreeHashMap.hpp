@@ -10,10 +10,12 @@
 #include <stdexcept>
 
 
+// Reclaimer 为内存回收器，可选 EBRManager 或 QSBRManager（见 getReclaimer）
 template <typename K, 
           typename V, 
           typename Hash = std::hash<K>, 
-          typename KeyEqual = std::equal_to<K>>
+          typename KeyEqual = std::equal_to<K>,
+          typename Reclaimer = EBRManager>
 class LockFreeHashMap {
 public:
     explicit LockFreeHashMap(size_t initial_bucket_count = 16);
@@ -34,14 +36,17 @@ public:
 
     size_t bucketCount() const noexcept;
 
+    // QSBR 模式下，线程需要通过它在循环边界调用 quiescent()
+    Reclaimer& getReclaimer() noexcept;
+
 private:
-    using Chain = LockFreeChain<K, V, KeyEqual>;
+    using Chain = LockFreeChain<K, V, KeyEqual, Reclaimer>;
 
     size_t getBucketIndex_(const K& key) const;
     static size_t roundUpToPowerOfTwo_(size_t n);
 
 private:
-    EBRManager ebr_;
+    Reclaimer ebr_;
     const size_t bucket_mask_;
     const size_t bucket_count_;
     std::unique_ptr<Chain[]> buckets_;
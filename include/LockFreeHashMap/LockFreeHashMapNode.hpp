@@ -4,9 +4,11 @@
 #include <cstdint>
 #include <utility>
 #include "Tool/StampPtrPacker.hpp"
+#include "EBRManager/EBRHook.hpp"
 
+// 继承 EBRHook：退休时直接串进线程本地的钩子链，不再分配 GarbageNode
 template <typename K, typename V>
-struct LockFreeHashMapNode {
+struct LockFreeHashMapNode : public EBRHook {
     using Node          = LockFreeHashMapNode<K, V>;
     using NodePtr       = Node*;
 
@@ -7,10 +7,14 @@
 
 #include "LockFreeLinkedList/LockFreeListNode.hpp"
 #include "Hazard/HazardPointerOrganizer.hpp"
+#include "Hazard/HazardPtrHolder.hpp"
 
 class DefaultHeapPolicy;
 
-template <class T, class AllocPolicy = DefaultHeapPolicy>
+// Organizer 可以是专用的 HazardPointerOrganizer、与其他容器共用的 HazardDomain，
+// 或者遍历开销更低的 HazardEraOrganizer
+template <class T, class AllocPolicy = DefaultHeapPolicy,
+          class Organizer = HazardPointerOrganizer<LockFreeListNode<T>, 2, AllocPolicy>>
 class LockFreeLinkedList {
 public:
     using value_type = T;
@@ -18,8 +22,10 @@ public:
     using node_ptr   = node_type*;
     using size_type  = std::size_t;
 
+    // 手递手遍历同时保护 prev 与 curr，由 HazardPtrHolder 动态领取下标
     static constexpr std::size_t kHazardPointers = 2; 
-    using hp_organizer_type = HazardPointerOrganizer<node_type, kHazardPointers, AllocPolicy>;
+    using hp_organizer_type = Organizer;
+    using hp_holder_type    = HazardPtrHolder<Organizer>;
 
     
 public:
@@ -33,11 +39,13 @@ public:
     bool isEmpty() const noexcept;
 
 private:
+    // 返回时 prev 受 prev_hp 保护（或为哨兵），curr 受 curr_hp 保护
     void find(
         const value_type& value, 
         node_ptr& prev, 
         node_ptr& curr, 
-        decltype(std::declval<hp_organizer_type>().acquireTlsSlot()) slot 
+        hp_holder_type& prev_hp,
+        hp_holder_type& curr_hp
     );
 
     node_type head_sentinel_;
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <utility> // for std::move
 
+#include "Hazard/GCHook.hpp"
+
 /**
  * @brief 免锁链表的节点 (Node for a Lock-Free Linked List)
  * 
@@ -15,9 +18,10 @@
  *     - 如果 LSB 是 0：节点是正常的、有效的。
  *     - 如果 LSB 是 1：节点已被“逻辑删除”，正在等待被物理摘除和内存回收。
  *     链表的操作逻辑（如 find, insert, delete）需要负责处理这个标记位的打包和解包。
+ * 3.  继承 GCHook，由危险指针回收器（HazardPointerOrganizer / HazardDomain）管理退休与释放。
  */
 template <class T>
-class LockFreeListNode {
+class LockFreeListNode : public GCHook {
 public:
     using node_ptr = LockFreeListNode<T>*;
 
@@ -1,14 +1,19 @@
 #pragma once
 #include <atomic>
 #include <cstddef>
+#include <chrono>
 
 #include "LockFreeQueue/QueueNode.hpp"
 #include "Hazard/HazardPointerOrganizer.hpp"
+#include "Tool/ShmEventCount.hpp"
+#include "Tool/AsymmetricFence.hpp"
 
 // 前向声明 AllocPolicy 的默认类型
 class DefaultHeapPolicy;
 
-template <class T, class AllocPolicy = DefaultHeapPolicy>
+// Organizer 可以是专用的 HazardPointerOrganizer，也可以是与其他容器共用的 HazardDomain
+template <class T, class AllocPolicy = DefaultHeapPolicy,
+          class Organizer = HazardPointerOrganizer<QueueNode<T>, 2, AllocPolicy>>
 class LockFreeQueue {
 public:
     using value_type = T;
@@ -19,7 +24,9 @@ public:
     // HP[0] 用于保护 head
     // HP[1] 用于保护 head->next (first_node)
     static constexpr std::size_t kHazardPointers = 2; 
-    using hp_organizer_type = HazardPointerOrganizer<node_type, kHazardPointers, AllocPolicy>;
+    using hp_organizer_type = Organizer;
+    static_assert(hp_organizer_type::kMaxPointers >= kHazardPointers,
+                  "Organizer provides too few hazard pointers per slot.");
 
 public:
     explicit LockFreeQueue(hp_organizer_type& hp_organizer) noexcept;
@@ -29,6 +36,8 @@ public:
     void push(const value_type& v);
     void push(value_type&& v);
     bool tryPop(value_type& out) noexcept;
+    // 阻塞出队：先短暂自旋，再挂起等待 push 唤醒；超时返回 false
+    bool pop(value_type& out, std::chrono::nanoseconds timeout);
     bool isEmpty() const noexcept;
 
 private:
@@ -40,6 +49,9 @@ private:
     alignas(64) std::atomic<node_type*> tail_;
 
     hp_organizer_type& hp_organizer_;
+
+    // 空队列时消费者在这里挂起
+    ShmEventCount not_empty_;
 };
 
 #include "LockFreeQueue_impl.hpp"
\ No newline at end of file
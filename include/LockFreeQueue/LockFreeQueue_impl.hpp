@@ -3,18 +3,21 @@
 #include "LockFreeQueue.hpp"
 
 // 构造函数 (无变化)
-template <class T, class AllocPolicy>
-LockFreeQueue<T, AllocPolicy>::LockFreeQueue(hp_organizer_type& hp_organizer) noexcept
+template <class T, class AllocPolicy, class Organizer>
+LockFreeQueue<T, AllocPolicy, Organizer>::LockFreeQueue(hp_organizer_type& hp_organizer) noexcept
     : hp_organizer_(hp_organizer) 
 {
     auto* dummy_node = AllocPolicy::template allocate<node_type>(); // 假设QueueNode有默认构造
+    // 共用 HazardDomain 时按真实类型、用本容器的 AllocPolicy 释放
+    dummy_node->gc_deleter = &gcDeleteAs<node_type, AllocPolicy>;
+    hp_organizer_.stampBirth(dummy_node);
     head_.store(dummy_node, std::memory_order_relaxed);
     tail_.store(dummy_node, std::memory_order_relaxed);
 }
 
 // 析构函数 (无变化)
-template <class T, class AllocPolicy>
-LockFreeQueue<T, AllocPolicy>::~LockFreeQueue() noexcept {
+template <class T, class AllocPolicy, class Organizer>
+LockFreeQueue<T, AllocPolicy, Organizer>::~LockFreeQueue() noexcept {
     value_type ignored;
     while (tryPop(ignored));
     node_type* dummy = head_.load(std::memory_order_relaxed);
@@ -22,20 +25,22 @@ LockFreeQueue<T, AllocPolicy>::~LockFreeQueue() noexcept {
 }
 
 // push 相关实现 (无变化)
-template <class T, class AllocPolicy>
-void LockFreeQueue<T, AllocPolicy>::push(const value_type& v) {
+template <class T, class AllocPolicy, class Organizer>
+void LockFreeQueue<T, AllocPolicy, Organizer>::push(const value_type& v) {
     pushImpl(v);
 }
 
-template <class T, class AllocPolicy>
-void LockFreeQueue<T, AllocPolicy>::push(value_type&& v) {
+template <class T, class AllocPolicy, class Organizer>
+void LockFreeQueue<T, AllocPolicy, Organizer>::push(value_type&& v) {
     pushImpl(std::move(v));
 }
 
-template <class T, class AllocPolicy>
+template <class T, class AllocPolicy, class Organizer>
 template<typename U>
-void LockFreeQueue<T, AllocPolicy>::pushImpl(U&& v) {
+void LockFreeQueue<T, AllocPolicy, Organizer>::pushImpl(U&& v) {
     auto* new_node = AllocPolicy::template allocate<node_type>(std::forward<U>(v));
+    new_node->gc_deleter = &gcDeleteAs<node_type, AllocPolicy>;
+    hp_organizer_.stampBirth(new_node);
     for (;;) {
         node_type* old_tail = tail_.load(std::memory_order_acquire);
         node_type* next = old_tail->next.load(std::memory_order_relaxed);
@@ -49,14 +54,15 @@ void LockFreeQueue<T, AllocPolicy>::pushImpl(U&& v) {
         node_type* null_next = nullptr;
         if (old_tail->next.compare_exchange_weak(null_next, new_node, std::memory_order_release, std::memory_order_relaxed)) {
             tail_.compare_exchange_strong(old_tail, new_node, std::memory_order_release, std::memory_order_relaxed);
+            not_empty_.notifyOne();
             return;
         }
     }
 }
 
 
-template <class T, class AllocPolicy>
-bool LockFreeQueue<T, AllocPolicy>::tryPop(value_type& out) noexcept {
+template <class T, class AllocPolicy, class Organizer>
+bool LockFreeQueue<T, AllocPolicy, Organizer>::tryPop(value_type& out) noexcept {
     auto* slot = hp_organizer_.acquireTlsSlot();
     for (;;) {
         // 1. 读取并保护 head
@@ -64,6 +70,8 @@ bool LockFreeQueue<T, AllocPolicy>::tryPop(value_type& out) noexcept {
         if (slot) {
             slot->protect(0, old_head);
         }
+        // protect 的写入必须先于下面的重读，与回收者的 AsymmetricFence::heavy() 配对
+        AsymmetricFence::light();
 
         // 2. 验证 head 在我们保护它之后没有改变
         if (old_head != head_.load(std::memory_order_acquire)) {
@@ -77,6 +85,7 @@ bool LockFreeQueue<T, AllocPolicy>::tryPop(value_type& out) noexcept {
         if (slot) {
             slot->protect(1, first_node);
         }
+        AsymmetricFence::light();
         
         // 4. 读取 tail 用于后续判断
         node_type* old_tail = tail_.load(std::memory_order_acquire);
@@ -137,8 +146,13 @@ bool LockFreeQueue<T, AllocPolicy>::tryPop(value_type& out) noexcept {
     }
 }
 
+template <class T, class AllocPolicy, class Organizer>
+bool LockFreeQueue<T, AllocPolicy, Organizer>::pop(value_type& out, std::chrono::nanoseconds timeout) {
+    return not_empty_.await([&]() { return tryPop(out); }, timeout);
+}
+
 // isEmpty (无变化)
-template <class T, class AllocPolicy>
-bool LockFreeQueue<T, AllocPolicy>::isEmpty() const noexcept {
+template <class T, class AllocPolicy, class Organizer>
+bool LockFreeQueue<T, AllocPolicy, Organizer>::isEmpty() const noexcept {
     return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
 }
\ No newline at end of file
@@ -4,8 +4,10 @@
 #include <type_traits>
 #include <utility>
 
+#include "Hazard/GCHook.hpp"
+
 template <typename T>
-class QueueNode {
+class QueueNode : public GCHook {
 public:
     using value_type = T;
 
@@ -21,10 +23,4 @@ public:
 
     explicit QueueNode(value_type&& val) noexcept(std::is_nothrow_move_constructible<T>::value)
         : next(nullptr), value(std::move(val)) {}
-
-private:
-    static void* operator new(size_t) = delete;
-    static void* operator new[](size_t) = delete;
-    static void operator delete(void*) = delete;
-    static void operator delete[](void*) = delete;
 };
\ No newline at end of file
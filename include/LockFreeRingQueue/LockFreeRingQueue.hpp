@@ -0,0 +1,79 @@
+// LockFreeRingQueue/LockFreeRingQueue.hpp
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief 有界 MPMC 环形队列（Vyukov 风格，每个槽位带序号）。
+ *
+ * 与 LockFreeQueue 不同，这里所有槽位都在对象内部预先分配：
+ * - 不依赖 HazardPointerOrganizer / ThreadHeap，没有任何节点回收开销；
+ * - 入队、出队各只需要一次 CAS（批量接口一次 CAS 认领多个槽位）；
+ * - 对象内部不含进程相关的指针，可以直接 placement new 到 ShmSegment 中跨进程共享。
+ *
+ * 槽位序号协议（pos 为全局递增的位置）：
+ * - sequence == pos           : 槽位空闲，可由认领 pos 的生产者写入
+ * - sequence == pos + 1       : 槽位已写入，可由认领 pos 的消费者读取
+ * - sequence == pos + Capacity: 槽位已被读走，留给下一圈的生产者
+ *
+ * @tparam T        元素类型，必须可平凡拷贝（跨进程按字节共享）
+ * @tparam Capacity 槽位数量，必须是 2 的幂
+ */
+template <class T, std::size_t Capacity>
+class LockFreeRingQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "LockFreeRingQueue capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "LockFreeRingQueue requires a trivially copyable value type");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                  "LockFreeRingQueue requires lock-free 64-bit atomics for shared memory");
+
+public:
+    using value_type = T;
+    using size_type  = std::size_t;
+
+    static constexpr size_type kCapacity = Capacity;
+
+public:
+    LockFreeRingQueue() noexcept;
+    ~LockFreeRingQueue() = default;
+
+    LockFreeRingQueue(const LockFreeRingQueue&) = delete;
+    LockFreeRingQueue& operator=(const LockFreeRingQueue&) = delete;
+    LockFreeRingQueue(LockFreeRingQueue&&) = delete;
+    LockFreeRingQueue& operator=(LockFreeRingQueue&&) = delete;
+
+    // 队列满时返回 false
+    bool tryPush(const value_type& v) noexcept;
+    // 队列空时返回 false
+    bool tryPop(value_type& out) noexcept;
+
+    // 批量接口：一次 CAS 认领连续槽位，返回实际入队/出队的个数（可能小于请求数）
+    size_type tryPushBatch(const value_type* items, size_type count) noexcept;
+    size_type tryPopBatch(value_type* out, size_type max_count) noexcept;
+
+    bool isEmpty() const noexcept;
+    size_type approxSize() const noexcept;
+
+    static constexpr size_type capacity() noexcept { return Capacity; }
+
+private:
+    struct Cell {
+        std::atomic<std::uint64_t> sequence;
+        value_type value;
+    };
+
+    static constexpr std::uint64_t kMask = Capacity - 1;
+
+    Cell& cellAt_(std::uint64_t pos) noexcept { return cells_[pos & kMask]; }
+
+    // 生产者与消费者游标分开放在不同缓存行，防止伪共享
+    alignas(64) std::atomic<std::uint64_t> enqueue_pos_;
+    alignas(64) std::atomic<std::uint64_t> dequeue_pos_;
+    alignas(64) Cell cells_[Capacity];
+};
+
+#include "LockFreeRingQueue_impl.hpp"
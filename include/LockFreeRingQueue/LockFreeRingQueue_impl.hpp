@@ -0,0 +1,164 @@
+#pragma once
+
+#include "LockFreeRingQueue.hpp"
+
+template <class T, std::size_t Capacity>
+LockFreeRingQueue<T, Capacity>::LockFreeRingQueue() noexcept {
+    for (std::uint64_t i = 0; i < Capacity; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    enqueue_pos_.store(0, std::memory_order_relaxed);
+    // 发布初始化结果，保证其他线程/进程看到的是完整的槽位序号
+    dequeue_pos_.store(0, std::memory_order_release);
+}
+
+template <class T, std::size_t Capacity>
+bool LockFreeRingQueue<T, Capacity>::tryPush(const value_type& v) noexcept {
+    std::uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = cellAt_(pos);
+        std::uint64_t seq = cell.sequence.load(std::memory_order_acquire);
+        std::int64_t diff = static_cast<std::int64_t>(seq - pos);
+
+        if (diff == 0) {
+            // 槽位空闲，尝试认领 pos
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                   std::memory_order_relaxed,
+                                                   std::memory_order_relaxed)) {
+                cell.value = v;
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+            // CAS 失败时 pos 已被刷新
+        } else if (diff < 0) {
+            // 上一圈的元素还没被读走：队列满
+            return false;
+        } else {
+            // 其他生产者已经越过 pos，重新读取
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <class T, std::size_t Capacity>
+bool LockFreeRingQueue<T, Capacity>::tryPop(value_type& out) noexcept {
+    std::uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell& cell = cellAt_(pos);
+        std::uint64_t seq = cell.sequence.load(std::memory_order_acquire);
+        std::int64_t diff = static_cast<std::int64_t>(seq - (pos + 1));
+
+        if (diff == 0) {
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                                   std::memory_order_relaxed,
+                                                   std::memory_order_relaxed)) {
+                out = cell.value;
+                // 把槽位交还给下一圈的生产者
+                cell.sequence.store(pos + Capacity, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            // 生产者尚未写入：队列空
+            return false;
+        } else {
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <class T, std::size_t Capacity>
+typename LockFreeRingQueue<T, Capacity>::size_type
+LockFreeRingQueue<T, Capacity>::tryPushBatch(const value_type* items, size_type count) noexcept {
+    if (!items || count == 0) return 0;
+    if (count > Capacity) count = Capacity;
+
+    std::uint64_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    size_type claimed = 0;
+    for (;;) {
+        // 从 pos 开始统计连续的空闲槽位
+        claimed = 0;
+        while (claimed < count &&
+               cellAt_(pos + claimed).sequence.load(std::memory_order_acquire) == pos + claimed) {
+            ++claimed;
+        }
+
+        if (claimed == 0) {
+            std::uint64_t seq = cellAt_(pos).sequence.load(std::memory_order_acquire);
+            if (static_cast<std::int64_t>(seq - pos) < 0) {
+                return 0; // 队列满
+            }
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        // 一次 CAS 认领 [pos, pos + claimed)
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + claimed,
+                                               std::memory_order_relaxed,
+                                               std::memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    for (size_type i = 0; i < claimed; ++i) {
+        Cell& cell = cellAt_(pos + i);
+        cell.value = items[i];
+        cell.sequence.store(pos + i + 1, std::memory_order_release);
+    }
+    return claimed;
+}
+
+template <class T, std::size_t Capacity>
+typename LockFreeRingQueue<T, Capacity>::size_type
+LockFreeRingQueue<T, Capacity>::tryPopBatch(value_type* out, size_type max_count) noexcept {
+    if (!out || max_count == 0) return 0;
+    if (max_count > Capacity) max_count = Capacity;
+
+    std::uint64_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    size_type claimed = 0;
+    for (;;) {
+        // 从 pos 开始统计连续的已写入槽位
+        claimed = 0;
+        while (claimed < max_count &&
+               cellAt_(pos + claimed).sequence.load(std::memory_order_acquire) == pos + claimed + 1) {
+            ++claimed;
+        }
+
+        if (claimed == 0) {
+            std::uint64_t seq = cellAt_(pos).sequence.load(std::memory_order_acquire);
+            if (static_cast<std::int64_t>(seq - (pos + 1)) < 0) {
+                return 0; // 队列空
+            }
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + claimed,
+                                               std::memory_order_relaxed,
+                                               std::memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    for (size_type i = 0; i < claimed; ++i) {
+        Cell& cell = cellAt_(pos + i);
+        out[i] = cell.value;
+        cell.sequence.store(pos + i + Capacity, std::memory_order_release);
+    }
+    return claimed;
+}
+
+template <class T, std::size_t Capacity>
+bool LockFreeRingQueue<T, Capacity>::isEmpty() const noexcept {
+    return approxSize() == 0;
+}
+
+template <class T, std::size_t Capacity>
+typename LockFreeRingQueue<T, Capacity>::size_type
+LockFreeRingQueue<T, Capacity>::approxSize() const noexcept {
+    // 先读出队游标，再读入队游标，保证差值不会为负
+    std::uint64_t head = dequeue_pos_.load(std::memory_order_acquire);
+    std::uint64_t tail = enqueue_pos_.load(std::memory_order_acquire);
+    if (tail <= head) return 0;
+    std::uint64_t size = tail - head;
+    return static_cast<size_type>(size > Capacity ? Capacity : size);
+}
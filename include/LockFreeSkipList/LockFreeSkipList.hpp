@@ -8,14 +8,16 @@
 #include "LockFreeSkipList/LockFreeSkipListNode.hpp"
 #include "EBRManager/EBRManager.hpp"
 
-template<typename Key, typename Value, typename Compare = std::less<Key>>
+// Reclaimer 为内存回收器，可选 EBRManager 或 QSBRManager
+template<typename Key, typename Value, typename Compare = std::less<Key>,
+         typename Reclaimer = EBRManager>
 class LockFreeSkipList {
 public:
     using Node   = LockFreeSkipListNode<Key, Value>;
     using Packer = StampPtrPacker<Node>;
     using Packed = typename Packer::type;
 
-    explicit LockFreeSkipList(EBRManager& ebr_manager);
+    explicit LockFreeSkipList(Reclaimer& ebr_manager);
     ~LockFreeSkipList();
 
     LockFreeSkipList(const LockFreeSkipList&) = delete;
@@ -30,7 +32,7 @@ public:
 public: // 公共类型定义和成员
     static constexpr int kMaxHeight = 4;
     Node* head_; 
-    EBRManager& ebr_manager_;
+    Reclaimer& ebr_manager_;
     Compare compare_;
 
 public: // 内部辅助函数
@@ -7,10 +7,12 @@
 
 #include "gc_malloc/ThreadHeap/ThreadHeap.hpp"
 #include "Tool/StampPtrPacker.hpp"
+#include "EBRManager/EBRHook.hpp"
 
 
+// 继承 EBRHook：退休时直接串进线程本地的钩子链，不再分配 GarbageNode
 template<typename Key, typename Value>
-class LockFreeSkipListNode {
+class LockFreeSkipListNode : public EBRHook {
 public:
     using Node         = LockFreeSkipListNode<Key, Value>;
     using Packer       = StampPtrPacker<Node>;
@@ -46,7 +48,8 @@ private:
 template<typename Node>
 static inline void* allocateNodeMemory(int height) {
     using AtomicPacked = typename Node::AtomicPacked;
-    size_t total_size = offsetof(Node, forward_) + sizeof(AtomicPacked) * height;
+    // 带基类后不再是标准布局，不能用 offsetof；sizeof(Node) 已含 forward_[0]
+    size_t total_size = sizeof(Node) + sizeof(AtomicPacked) * (height - 1);
     return ThreadHeap::allocate(total_size);
 }
 
@@ -5,31 +5,31 @@
 
 // --- 辅助函数 (标记指针 & 随机层高) ---
 
-template<typename K, typename V, typename C>
-typename LockFreeSkipList<K, V, C>::Node* 
-LockFreeSkipList<K, V, C>::getMarked_(Node* ptr) const noexcept {
+template<typename K, typename V, typename C, typename R>
+typename LockFreeSkipList<K, V, C, R>::Node* 
+LockFreeSkipList<K, V, C, R>::getMarked_(Node* ptr) const noexcept {
     return reinterpret_cast<Node*>(reinterpret_cast<uintptr_t>(ptr) | 1);
 }
 
-template<typename K, typename V, typename C>
-bool LockFreeSkipList<K, V, C>::isMarked_(typename LockFreeSkipList<K, V, C>::Node* ptr) const noexcept {
+template<typename K, typename V, typename C, typename R>
+bool LockFreeSkipList<K, V, C, R>::isMarked_(typename LockFreeSkipList<K, V, C, R>::Node* ptr) const noexcept {
     return (reinterpret_cast<uintptr_t>(ptr) & 1) != 0;
 }
 
-template<typename K, typename V, typename C>
-typename LockFreeSkipList<K, V, C>::Node* 
-LockFreeSkipList<K, V, C>::getUnmarked_(Node* ptr) const noexcept {
+template<typename K, typename V, typename C, typename R>
+typename LockFreeSkipList<K, V, C, R>::Node* 
+LockFreeSkipList<K, V, C, R>::getUnmarked_(Node* ptr) const noexcept {
     return reinterpret_cast<Node*>(reinterpret_cast<uintptr_t>(ptr) & ~1);
 }
 
-template<typename K, typename V, typename C>
-std::mt19937& LockFreeSkipList<K, V, C>::get_random_engine_() {
+template<typename K, typename V, typename C, typename R>
+std::mt19937& LockFreeSkipList<K, V, C, R>::get_random_engine_() {
     thread_local static std::mt19937 engine(std::random_device{}());
     return engine;
 }
 
-template<typename K, typename V, typename C>
-int LockFreeSkipList<K, V, C>::random_height_(){
+template<typename K, typename V, typename C, typename R>
+int LockFreeSkipList<K, V, C, R>::random_height_(){
     std::geometric_distribution<> dist(0.5);
     int height = dist(this->get_random_engine_()) + 1;
     return std::min(height, kMaxHeight);
@@ -37,15 +37,15 @@ int LockFreeSkipList<K, V, C>::random_height_(){
 
 
 // --- 构造与析构 ---
-template<typename K, typename V, typename C>
-LockFreeSkipList<K, V, C>::LockFreeSkipList(EBRManager& ebr_manager)
+template<typename K, typename V, typename C, typename R>
+LockFreeSkipList<K, V, C, R>::LockFreeSkipList(R& ebr_manager)
     : ebr_manager_(ebr_manager), compare_(){
     K min_key = std::numeric_limits<K>::min(); 
     head_ = Node::createHead(min_key, kMaxHeight);
 }
 
-template<typename K, typename V, typename C>
-LockFreeSkipList<K, V, C>::~LockFreeSkipList() {
+template<typename K, typename V, typename C, typename R>
+LockFreeSkipList<K, V, C, R>::~LockFreeSkipList() {
     Node* current = head_;
     while (current != nullptr) {
         Packed pnext = current->nextSlot(0).load(std::memory_order_relaxed);
@@ -57,13 +57,14 @@ LockFreeSkipList<K, V, C>::~LockFreeSkipList() {
 
 
 // --- 核心实现 (最终修复版) ---
-template<typename K, typename V, typename C>
-void LockFreeSkipList<K, V, C>::findNode_(const K& key, Node* prevs[], Node* nexts[]) {
+template<typename K, typename V, typename C, typename R>
+void LockFreeSkipList<K, V, C, R>::findNode_(const K& key, Node* prevs[], Node* nexts[]) {
 search_again:
     Node* pred = head_;
 
     for (int level = kMaxHeight - 1; level >= 0; --level) {
-        Packed pred_next_packed = pred->nextSlot(level).load(std::memory_order_acquire);
+        // 会被解引用的指针都经 ebr::load 读取（健壮模式下维护保留区间）
+        Packed pred_next_packed = ebr::load(ebr_manager_, pred->nextSlot(level));
         Node*  curr     = Packer::unpackPtr(pred_next_packed);
 
         while (true) {
@@ -90,7 +91,7 @@ search_again:
             } else {
                 if (compare_(succ->key, key)) {
                     pred = succ;
-                    pred_next_packed = pred->nextSlot(level).load(std::memory_order_acquire);
+                    pred_next_packed = ebr::load(ebr_manager_, pred->nextSlot(level));
                     curr     = Packer::unpackPtr(pred_next_packed);
                 } else {
                     break;
@@ -104,8 +105,8 @@ search_again:
 }
 
 
-template<typename K, typename V, typename C>
-bool LockFreeSkipList<K, V, C>::find(const K& key, V& value) {
+template<typename K, typename V, typename C, typename R>
+bool LockFreeSkipList<K, V, C, R>::find(const K& key, V& value) {
     ebr::Guard guard(ebr_manager_);
 
     Node* prevs[kMaxHeight];
@@ -123,8 +124,8 @@ bool LockFreeSkipList<K, V, C>::find(const K& key, V& value) {
 }
 
 
-template<typename K, typename V, typename C>
-bool LockFreeSkipList<K, V, C>::insert(const K& key, const V& value) {
+template<typename K, typename V, typename C, typename R>
+bool LockFreeSkipList<K, V, C, R>::insert(const K& key, const V& value) {
     ebr::Guard guard(ebr_manager_);
 
     Node* prevs[kMaxHeight];
@@ -140,6 +141,7 @@ bool LockFreeSkipList<K, V, C>::insert(const K& key, const V& value) {
 
         int   height   = random_height_();
         Node* new_node = Node::create(key, value, height);
+        ebr::stampBirth(ebr_manager_, new_node);
 
         // 初始化 new_node 的 forward
         for (int i = 0; i < height; ++i) {
@@ -182,8 +184,8 @@ bool LockFreeSkipList<K, V, C>::insert(const K& key, const V& value) {
 }
 
 
-template<typename K, typename V, typename C>
-bool LockFreeSkipList<K, V, C>::tryMarkForRemoval_(Node* node_to_delete) {
+template<typename K, typename V, typename C, typename R>
+bool LockFreeSkipList<K, V, C, R>::tryMarkForRemoval_(Node* node_to_delete) {
     while (true) {
         Packed exp = node_to_delete->nextSlot(0).load(std::memory_order_acquire);
         Node*  succ = Packer::unpackPtr(exp);
@@ -201,8 +203,8 @@ bool LockFreeSkipList<K, V, C>::tryMarkForRemoval_(Node* node_to_delete) {
 
 
 
-template<typename K, typename V, typename C>
-bool LockFreeSkipList<K, V, C>::remove(const K& key) {
+template<typename K, typename V, typename C, typename R>
+bool LockFreeSkipList<K, V, C, R>::remove(const K& key) {
     ebr::Guard guard(ebr_manager_);
 
     Node* prevs[kMaxHeight];
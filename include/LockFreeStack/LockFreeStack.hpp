@@ -3,15 +3,20 @@
 // #include <atomic>
 
 #include <cstddef>
+#include <chrono>
 #include "atomics/x86_atomics.hpp" 
 #include "Tool/StampPtr.hpp"
 #include "LockFreeStack/StackNode.hpp"
 #include "Hazard/HazardPointerOrganizer.hpp"
+#include "Tool/ShmEventCount.hpp"
+#include "Tool/AsymmetricFence.hpp"
 
 // 前向声明 AllocPolicy 的默认类型
 class DefaultHeapPolicy;
 
-template <class T, class AllocPolicy = DefaultHeapPolicy>
+// Organizer 可以是专用的 HazardPointerOrganizer，也可以是与其他容器共用的 HazardDomain
+template <class T, class AllocPolicy = DefaultHeapPolicy,
+          class Organizer = HazardPointerOrganizer<StackNode<T>, 1, AllocPolicy>>
 class LockFreeStack {
 public:
     using value_type = T;
@@ -19,7 +24,9 @@ public:
     using size_type  = std::size_t;
 
     static constexpr std::size_t kHazardPointers = 1;
-    using hp_organizer_type = HazardPointerOrganizer<node_type, kHazardPointers, AllocPolicy>;
+    using hp_organizer_type = Organizer;
+    static_assert(hp_organizer_type::kMaxPointers >= kHazardPointers,
+                  "Organizer provides too few hazard pointers per slot.");
 
 public:
     explicit LockFreeStack(hp_organizer_type& hp_organizer) noexcept;
@@ -28,6 +35,8 @@ public:
     void push(const value_type& v);
     void push(value_type&& v);
     bool tryPop(value_type& out) noexcept;
+    // 阻塞出栈：先短暂自旋，再挂起等待 push 唤醒；超时返回 false
+    bool pop(value_type& out, std::chrono::nanoseconds timeout);
     bool isEmpty() const noexcept;
 
 
@@ -35,6 +44,9 @@ private:
     Atomic<uint64_t> head_{0}; 
     using HeadPacker = StampPtr<node_type, Atomic<uint64_t>>;
     hp_organizer_type& hp_organizer_;
+
+    // 空栈时消费者在这里挂起
+    ShmEventCount not_empty_;
 };
 
 // 在头文件末尾包含实现，实现 Header-Only
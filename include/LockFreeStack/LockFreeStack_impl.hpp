@@ -1,13 +1,13 @@
 // LockFreeStack_impl.hpp
 #pragma once
 
-template <class T, class AllocPolicy>
-LockFreeStack<T, AllocPolicy>::LockFreeStack(hp_organizer_type& hp_organizer) noexcept
-    : hp_organizer_(hp_organizer), head_{0} {}
+template <class T, class AllocPolicy, class Organizer>
+LockFreeStack<T, AllocPolicy, Organizer>::LockFreeStack(hp_organizer_type& hp_organizer) noexcept
+    : head_{0}, hp_organizer_(hp_organizer) {}
 
 
-template <class T, class AllocPolicy>
-LockFreeStack<T, AllocPolicy>::~LockFreeStack() noexcept {
+template <class T, class AllocPolicy, class Organizer>
+LockFreeStack<T, AllocPolicy, Organizer>::~LockFreeStack() noexcept {
     value_type discard_val;
     while (tryPop(discard_val)) {
         // 循环弹出直到为空，tryPop 内部会调用 retire
@@ -15,19 +15,25 @@ LockFreeStack<T, AllocPolicy>::~LockFreeStack() noexcept {
 }
 
 
-template <class T, class AllocPolicy>
-void LockFreeStack<T, AllocPolicy>::push(const value_type& v) {
+template <class T, class AllocPolicy, class Organizer>
+void LockFreeStack<T, AllocPolicy, Organizer>::push(const value_type& v) {
     auto* new_node = AllocPolicy::template allocate<node_type>(v);
+    // 共用 HazardDomain 时按真实类型、用本容器的 AllocPolicy 释放
+    new_node->gc_deleter = &gcDeleteAs<node_type, AllocPolicy>;
+    hp_organizer_.stampBirth(new_node);
     HeadPacker packer(head_); 
     auto current = packer.load(MemoryOrder::Relaxed);
     do {
         new_node->next = current.ptr;
     } while (!packer.casBump(current, new_node, MemoryOrder::AcqRel, MemoryOrder::Relaxed));
+    not_empty_.notifyOne();
 }
 
-template <class T, class AllocPolicy>
-void LockFreeStack<T, AllocPolicy>::push(value_type&& v) {
+template <class T, class AllocPolicy, class Organizer>
+void LockFreeStack<T, AllocPolicy, Organizer>::push(value_type&& v) {
     auto* new_node = AllocPolicy::template allocate<node_type>(std::move(v));
+    new_node->gc_deleter = &gcDeleteAs<node_type, AllocPolicy>;
+    hp_organizer_.stampBirth(new_node);
 
     HeadPacker packer(head_);
     auto current = packer.load(MemoryOrder::Relaxed);
@@ -35,10 +41,11 @@ void LockFreeStack<T, AllocPolicy>::push(value_type&& v) {
     do {
         new_node->next = current.ptr;
     } while (!packer.casBump(current, new_node, MemoryOrder::AcqRel, MemoryOrder::Relaxed));
+    not_empty_.notifyOne();
 }
 
-template <class T, class AllocPolicy>
-bool LockFreeStack<T, AllocPolicy>::tryPop(value_type& out) noexcept {
+template <class T, class AllocPolicy, class Organizer>
+bool LockFreeStack<T, AllocPolicy, Organizer>::tryPop(value_type& out) noexcept {
 
     auto* slot = hp_organizer_.acquireTlsSlot();
     if (!slot) return false;
@@ -56,7 +63,8 @@ bool LockFreeStack<T, AllocPolicy>::tryPop(value_type& out) noexcept {
 
         slot->protect(0, old_head_ptr);
         
-        atomic_thread_fence(MemoryOrder::SeqCst);
+        // 与回收者扫描前的 AsymmetricFence::heavy() 配对
+        AsymmetricFence::light();
 
         if (old_head_packed != packer.load(MemoryOrder::Acquire)) {
             continue;
@@ -79,8 +87,13 @@ bool LockFreeStack<T, AllocPolicy>::tryPop(value_type& out) noexcept {
     }
 }
 
-template <class T, class AllocPolicy>
-bool LockFreeStack<T, AllocPolicy>::isEmpty() const noexcept {
+template <class T, class AllocPolicy, class Organizer>
+bool LockFreeStack<T, AllocPolicy, Organizer>::pop(value_type& out, std::chrono::nanoseconds timeout) {
+    return not_empty_.await([&]() { return tryPop(out); }, timeout);
+}
+
+template <class T, class AllocPolicy, class Organizer>
+bool LockFreeStack<T, AllocPolicy, Organizer>::isEmpty() const noexcept {
     HeadPacker packer(const_cast<Atomic<uint64_t>&>(head_)); 
     return packer.load(MemoryOrder::Acquire).ptr == nullptr;
 }
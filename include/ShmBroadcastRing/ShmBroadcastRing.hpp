@@ -0,0 +1,110 @@
+// ShmBroadcastRing/ShmBroadcastRing.hpp
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief 单写者、多读者的广播环形缓冲区，用于把同一条记录扇出给多个消费进程。
+ *
+ * 写者每条记录只写一次；每个订阅者持有自己的读游标（Subscriber，放在订阅者自己的内存里），
+ * 读取过程不会写任何共享缓存行，读者数量不影响写者。
+ * 写者从不等待读者：读者过慢被“套圈”时，通过槽位序号检测到溢出，
+ * 跳到仍然有效的最旧记录继续读，并累计丢失的记录数。
+ *
+ * 槽位序号协议（pos 为全局递增的写位置）：
+ * - sequence == 2 * pos + 1 : 写者正在写入 pos
+ * - sequence == 2 * pos + 2 : pos 已发布，可读
+ * 读者在 pos 处看到更小的序号表示尚未发布，更大的序号表示已被下一圈覆盖。
+ *
+ * 对象内部只使用下标，可直接 placement new 到 ShmSegment 中跨进程共享。
+ *
+ * @tparam T        记录类型，必须可平凡拷贝（读者可能读到被覆盖中的字节，随后通过序号丢弃）
+ * @tparam Capacity 槽位数量，必须是 2 的幂
+ */
+template <class T, std::size_t Capacity>
+class ShmBroadcastRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "ShmBroadcastRing capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "ShmBroadcastRing requires a trivially copyable value type");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                  "ShmBroadcastRing requires lock-free 64-bit atomics for shared memory");
+
+public:
+    using value_type = T;
+    using size_type  = std::size_t;
+
+    static constexpr size_type kCapacity = Capacity;
+
+    enum class ReadResult {
+        kOk,       // 读到一条记录
+        kEmpty,    // 没有新记录
+        kOverrun,  // 被写者套圈，游标已跳到最旧的有效记录，丢失数见 Subscriber::getLostCount()
+    };
+
+    /**
+     * @brief 订阅者的私有读游标，由各读者自己持有（栈上或进程私有内存）。
+     */
+    class Subscriber {
+    public:
+        Subscriber() noexcept = default;
+
+        std::uint64_t getPosition() const noexcept { return cursor_; }
+        std::uint64_t getLostCount() const noexcept { return lost_; }
+
+    private:
+        friend class ShmBroadcastRing;
+        explicit Subscriber(std::uint64_t start) noexcept : cursor_(start) {}
+
+        std::uint64_t cursor_{0};
+        std::uint64_t lost_{0};
+    };
+
+public:
+    ShmBroadcastRing() noexcept;
+    ~ShmBroadcastRing() = default;
+
+    ShmBroadcastRing(const ShmBroadcastRing&) = delete;
+    ShmBroadcastRing& operator=(const ShmBroadcastRing&) = delete;
+    ShmBroadcastRing(ShmBroadcastRing&&) = delete;
+    ShmBroadcastRing& operator=(ShmBroadcastRing&&) = delete;
+
+    // --- 写者接口（同一时刻只允许一个写者）---
+    // 总是成功；最旧的记录会被覆盖
+    void publish(const value_type& v) noexcept;
+
+    // --- 读者接口 ---
+    // 从当前写位置开始订阅，只会读到订阅之后发布的记录
+    Subscriber subscribe() const noexcept;
+    // 从仍然有效的最旧记录开始订阅
+    Subscriber subscribeFromOldest() const noexcept;
+
+    ReadResult read(Subscriber& sub, value_type& out) const noexcept;
+
+    // 写者已发布的记录总数
+    std::uint64_t getWritePosition() const noexcept;
+
+    static constexpr size_type capacity() noexcept { return Capacity; }
+
+private:
+    struct Slot {
+        std::atomic<std::uint64_t> sequence;
+        value_type value;
+    };
+
+    static constexpr std::uint64_t kMask = Capacity - 1;
+
+    Slot&       slotAt_(std::uint64_t pos) noexcept { return slots_[pos & kMask]; }
+    const Slot& slotAt_(std::uint64_t pos) const noexcept { return slots_[pos & kMask]; }
+
+    std::uint64_t oldestValid_() const noexcept;
+
+    // 写位置独占一个缓存行；读者只在订阅和溢出时读取它
+    alignas(64) std::atomic<std::uint64_t> write_pos_;
+    alignas(64) Slot slots_[Capacity];
+};
+
+#include "ShmBroadcastRing_impl.hpp"
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "ShmBroadcastRing.hpp"
+
+template <class T, std::size_t Capacity>
+ShmBroadcastRing<T, Capacity>::ShmBroadcastRing() noexcept {
+    for (std::uint64_t i = 0; i < Capacity; ++i) {
+        slots_[i].sequence.store(0, std::memory_order_relaxed);
+    }
+    // 发布初始化结果
+    write_pos_.store(0, std::memory_order_release);
+}
+
+// ---------------- 写者 ----------------
+
+template <class T, std::size_t Capacity>
+void ShmBroadcastRing<T, Capacity>::publish(const value_type& v) noexcept {
+    const std::uint64_t pos = write_pos_.load(std::memory_order_relaxed);
+    Slot& slot = slotAt_(pos);
+
+    // 先标记“写入中”，读者在拷贝前后对比序号即可发现被覆盖
+    slot.sequence.store(2 * pos + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.value = v;
+
+    slot.sequence.store(2 * pos + 2, std::memory_order_release);
+    write_pos_.store(pos + 1, std::memory_order_release);
+}
+
+// ---------------- 读者 ----------------
+
+template <class T, std::size_t Capacity>
+typename ShmBroadcastRing<T, Capacity>::Subscriber
+ShmBroadcastRing<T, Capacity>::subscribe() const noexcept {
+    return Subscriber(write_pos_.load(std::memory_order_acquire));
+}
+
+template <class T, std::size_t Capacity>
+typename ShmBroadcastRing<T, Capacity>::Subscriber
+ShmBroadcastRing<T, Capacity>::subscribeFromOldest() const noexcept {
+    return Subscriber(oldestValid_());
+}
+
+template <class T, std::size_t Capacity>
+typename ShmBroadcastRing<T, Capacity>::ReadResult
+ShmBroadcastRing<T, Capacity>::read(Subscriber& sub, value_type& out) const noexcept {
+    const std::uint64_t pos      = sub.cursor_;
+    const std::uint64_t expected = 2 * pos + 2;
+    const Slot& slot = slotAt_(pos);
+
+    const std::uint64_t before = slot.sequence.load(std::memory_order_acquire);
+    if (before < expected) {
+        return ReadResult::kEmpty; // 尚未发布（或写者正在写 pos）
+    }
+
+    if (before == expected) {
+        value_type tmp = slot.value;
+        // 拷贝之后再次确认序号：期间被下一圈覆盖则丢弃这次拷贝
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == expected) {
+            out = tmp;
+            sub.cursor_ = pos + 1;
+            return ReadResult::kOk;
+        }
+    }
+
+    // 被套圈：跳到最旧的有效记录
+    const std::uint64_t oldest = oldestValid_();
+    if (oldest > pos) {
+        sub.lost_  += oldest - pos;
+        sub.cursor_ = oldest;
+    }
+    return ReadResult::kOverrun;
+}
+
+template <class T, std::size_t Capacity>
+std::uint64_t ShmBroadcastRing<T, Capacity>::getWritePosition() const noexcept {
+    return write_pos_.load(std::memory_order_acquire);
+}
+
+template <class T, std::size_t Capacity>
+std::uint64_t ShmBroadcastRing<T, Capacity>::oldestValid_() const noexcept {
+    const std::uint64_t w = write_pos_.load(std::memory_order_acquire);
+    // 写者下一条要覆盖的就是 w - Capacity，所以多留一个槽位的余量
+    return (w >= Capacity) ? w - Capacity + 1 : 0;
+}
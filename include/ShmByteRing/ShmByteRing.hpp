@@ -0,0 +1,109 @@
+// ShmByteRing/ShmByteRing.hpp
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 面向字节的单生产者/单消费者环形缓冲区，用于零拷贝 IPC 变长消息。
+ *
+ * 生产者：reserve(n) 拿到一段共享内存 -> 原地序列化 -> commit() 发布；
+ * 消费者：peek() 直接读取共享内存中的记录 -> release() 归还空间。
+ * 整个过程中消息只在共享内存里写一次，不需要再拷贝进节点或拷出到私有缓冲区。
+ *
+ * 记录布局：8 字节记录头 + 负载，整体按 8 字节对齐。
+ * 当尾部剩余空间放不下一条记录时，写入一条“填充记录”占满尾部，
+ * 真正的记录从缓冲区开头开始，因此每条负载在内存中总是连续的。
+ *
+ * 对象内部只使用偏移量，可直接 placement new 到 ShmSegment 中跨进程共享。
+ * 同一时刻只允许一个生产者线程和一个消费者线程。
+ *
+ * @tparam Capacity 缓冲区字节数，必须是 2 的幂；单条记录的负载上限为 Capacity / 2 - 8
+ */
+template <std::size_t Capacity>
+class ShmByteRing {
+    static_assert(Capacity >= 64 && (Capacity & (Capacity - 1)) == 0,
+                  "ShmByteRing capacity must be a power of two and at least 64 bytes");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                  "ShmByteRing requires lock-free 64-bit atomics for shared memory");
+
+public:
+    using size_type = std::size_t;
+
+    // 消费者看到的一条记录（指针直接指向共享内存）
+    struct Record {
+        const void* data{nullptr};
+        size_type   size{0};
+    };
+
+    static constexpr size_type kCapacity    = Capacity;
+    static constexpr size_type kRecordAlign = 8;
+
+public:
+    ShmByteRing() noexcept;
+    ~ShmByteRing() = default;
+
+    ShmByteRing(const ShmByteRing&) = delete;
+    ShmByteRing& operator=(const ShmByteRing&) = delete;
+    ShmByteRing(ShmByteRing&&) = delete;
+    ShmByteRing& operator=(ShmByteRing&&) = delete;
+
+    // --- 生产者接口 ---
+    // 预留 n 字节的可写空间；空间不足或 n 超过上限时返回 nullptr。
+    // 未 commit 之前再次 reserve 会覆盖上一次的预留。
+    void* reserve(size_type n) noexcept;
+    // 发布最近一次 reserve 的完整大小
+    void commit() noexcept;
+    // 只发布前 used 字节（used 不得超过预留大小），用于事先不知道确切长度的序列化
+    void commit(size_type used) noexcept;
+
+    // --- 消费者接口 ---
+    // 读取队首记录但不出队；为空时返回 false。
+    bool peek(Record& out) noexcept;
+    // 出队最近一次 peek 到的记录
+    void release() noexcept;
+
+    bool isEmpty() const noexcept;
+    size_type bytesInUse() const noexcept;
+
+    static constexpr size_type maxRecordSize() noexcept {
+        return Capacity / 2 - sizeof(RecordHeader);
+    }
+
+private:
+    struct RecordHeader {
+        std::uint32_t size;   // 负载字节数（填充记录为填充的负载长度）
+        std::uint32_t flags;
+    };
+
+    static constexpr std::uint32_t kPaddingFlag = 1u;
+    static constexpr std::uint64_t kMask = Capacity - 1;
+
+    static constexpr size_type alignUp_(size_type n) noexcept {
+        return (n + kRecordAlign - 1) & ~(kRecordAlign - 1);
+    }
+
+    RecordHeader* headerAt_(std::uint64_t pos) noexcept {
+        return reinterpret_cast<RecordHeader*>(buffer_ + (pos & kMask));
+    }
+
+    void publish_(size_type used) noexcept;
+
+private:
+    // --- 生产者独占的缓存行 ---
+    alignas(64) std::atomic<std::uint64_t> write_pos_;
+    std::uint64_t cached_read_pos_;    // 生产者对 read_pos_ 的本地缓存
+    std::uint64_t pending_pos_;        // 当前预留记录的记录头位置
+    std::uint64_t pending_skip_;       // 预留前需要跳过的填充字节数（kNoPending 表示没有预留）
+    std::uint64_t pending_size_;       // 当前预留的负载大小（可以为 0）
+
+    // --- 消费者独占的缓存行 ---
+    alignas(64) std::atomic<std::uint64_t> read_pos_;
+    std::uint64_t cached_write_pos_;   // 消费者对 write_pos_ 的本地缓存
+    std::uint64_t peeked_bytes_;       // 最近一次 peek 的记录总长度（0 表示没有）
+
+    alignas(64) unsigned char buffer_[Capacity];
+};
+
+#include "ShmByteRing_impl.hpp"
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "ShmByteRing.hpp"
+
+namespace ShmByteRingDetail {
+// pending_skip_ 取该值表示当前没有未提交的预留
+constexpr std::uint64_t kNoPending = ~std::uint64_t{0};
+}
+
+template <std::size_t Capacity>
+ShmByteRing<Capacity>::ShmByteRing() noexcept
+    : cached_read_pos_(0),
+      pending_pos_(0),
+      pending_skip_(ShmByteRingDetail::kNoPending),
+      pending_size_(0),
+      cached_write_pos_(0),
+      peeked_bytes_(0) {
+    write_pos_.store(0, std::memory_order_relaxed);
+    // 发布初始化结果
+    read_pos_.store(0, std::memory_order_release);
+}
+
+// ---------------- 生产者 ----------------
+
+template <std::size_t Capacity>
+void* ShmByteRing<Capacity>::reserve(size_type n) noexcept {
+    if (n > maxRecordSize()) {
+        return nullptr;
+    }
+
+    const std::uint64_t w         = write_pos_.load(std::memory_order_relaxed);
+    const size_type     total     = alignUp_(sizeof(RecordHeader) + n);
+    const size_type     tail_room = Capacity - static_cast<size_type>(w & kMask);
+    // 尾部放不下时，用一条填充记录占满尾部，记录本体从缓冲区开头开始
+    const size_type     skip      = (tail_room < total) ? tail_room : 0;
+    const std::uint64_t end       = w + skip + total;
+
+    if (end - cached_read_pos_ > Capacity) {
+        // 本地缓存不够用时才去读消费者的游标
+        cached_read_pos_ = read_pos_.load(std::memory_order_acquire);
+        if (end - cached_read_pos_ > Capacity) {
+            return nullptr; // 空间不足
+        }
+    }
+
+    pending_pos_  = w + skip;
+    pending_skip_ = skip;
+    pending_size_ = n;
+    return reinterpret_cast<unsigned char*>(headerAt_(pending_pos_)) + sizeof(RecordHeader);
+}
+
+template <std::size_t Capacity>
+void ShmByteRing<Capacity>::commit() noexcept {
+    publish_(static_cast<size_type>(pending_size_));
+}
+
+template <std::size_t Capacity>
+void ShmByteRing<Capacity>::commit(size_type used) noexcept {
+    publish_(used);
+}
+
+template <std::size_t Capacity>
+void ShmByteRing<Capacity>::publish_(size_type used) noexcept {
+    if (pending_skip_ == ShmByteRingDetail::kNoPending) {
+        return; // 没有预留
+    }
+    if (used > pending_size_) {
+        used = static_cast<size_type>(pending_size_);
+    }
+
+    if (pending_skip_ != 0) {
+        RecordHeader* pad = headerAt_(pending_pos_ - pending_skip_);
+        pad->size  = static_cast<std::uint32_t>(pending_skip_ - sizeof(RecordHeader));
+        pad->flags = kPaddingFlag;
+    }
+
+    RecordHeader* hdr = headerAt_(pending_pos_);
+    hdr->size  = static_cast<std::uint32_t>(used);
+    hdr->flags = 0;
+
+    // 释放语义：记录头与负载的写入先于游标对消费者可见
+    write_pos_.store(pending_pos_ + alignUp_(sizeof(RecordHeader) + used),
+                     std::memory_order_release);
+    pending_skip_ = ShmByteRingDetail::kNoPending;
+}
+
+// ---------------- 消费者 ----------------
+
+template <std::size_t Capacity>
+bool ShmByteRing<Capacity>::peek(Record& out) noexcept {
+    std::uint64_t r = read_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+        if (r == cached_write_pos_) {
+            cached_write_pos_ = write_pos_.load(std::memory_order_acquire);
+            if (r == cached_write_pos_) {
+                return false; // 空
+            }
+        }
+
+        const RecordHeader* hdr = headerAt_(r);
+        if (hdr->flags & kPaddingFlag) {
+            // 填充记录没有内容，直接跳过并归还空间
+            r += sizeof(RecordHeader) + hdr->size;
+            read_pos_.store(r, std::memory_order_release);
+            continue;
+        }
+
+        out.data      = reinterpret_cast<const unsigned char*>(hdr) + sizeof(RecordHeader);
+        out.size      = hdr->size;
+        peeked_bytes_ = alignUp_(sizeof(RecordHeader) + hdr->size);
+        return true;
+    }
+}
+
+template <std::size_t Capacity>
+void ShmByteRing<Capacity>::release() noexcept {
+    if (peeked_bytes_ == 0) {
+        return;
+    }
+    const std::uint64_t r = read_pos_.load(std::memory_order_relaxed);
+    // 释放语义：对记录的读取先于空间被生产者复用
+    read_pos_.store(r + peeked_bytes_, std::memory_order_release);
+    peeked_bytes_ = 0;
+}
+
+template <std::size_t Capacity>
+bool ShmByteRing<Capacity>::isEmpty() const noexcept {
+    return bytesInUse() == 0;
+}
+
+template <std::size_t Capacity>
+typename ShmByteRing<Capacity>::size_type ShmByteRing<Capacity>::bytesInUse() const noexcept {
+    const std::uint64_t r = read_pos_.load(std::memory_order_acquire);
+    const std::uint64_t w = write_pos_.load(std::memory_order_acquire);
+    return static_cast<size_type>(w - r);
+}
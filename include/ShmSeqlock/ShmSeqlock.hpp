@@ -0,0 +1,117 @@
+// ShmSeqlock/ShmSeqlock.hpp
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief 顺序锁保护的共享快照，适合“多进程频繁读、偶尔更新”的配置/状态表。
+ *
+ * 读者只读序号和数据，不写任何共享缓存行；只有与写者并发时才重试。
+ * 写者之间用序号本身串行化：CAS 把偶数序号改成奇数即获得写权限。
+ *
+ * 对象不含进程相关的指针，可直接 placement new 到 ShmSegment 中跨进程共享。
+ *
+ * @tparam T 快照类型，必须可平凡拷贝（读者可能拷到写了一半的字节，随后通过序号丢弃）
+ */
+template <class T>
+class ShmSeqlock {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "ShmSeqlock requires a trivially copyable value type");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                  "ShmSeqlock requires lock-free 64-bit atomics for shared memory");
+
+public:
+    using value_type = T;
+
+public:
+    ShmSeqlock() noexcept;
+    explicit ShmSeqlock(const value_type& init) noexcept;
+    ~ShmSeqlock() = default;
+
+    ShmSeqlock(const ShmSeqlock&) = delete;
+    ShmSeqlock& operator=(const ShmSeqlock&) = delete;
+    ShmSeqlock(ShmSeqlock&&) = delete;
+    ShmSeqlock& operator=(ShmSeqlock&&) = delete;
+
+    // --- 读者接口 ---
+    // 读取一致的快照；与写者并发时自旋重试
+    value_type load() const noexcept;
+    // 只尝试一次：没有写者干扰时返回 true
+    bool tryLoad(value_type& out) const noexcept;
+
+    // --- 写者接口 ---
+    void store(const value_type& v) noexcept;
+    // 在写权限内原地修改快照（读-改-写），fn 签名为 void(value_type&)
+    template <class Fn>
+    void update(Fn&& fn) noexcept(noexcept(fn(std::declval<value_type&>())));
+
+    // 每次完整写入序号加 2；奇数表示写入中
+    std::uint64_t getSequence() const noexcept;
+
+private:
+    std::uint64_t lockWriter_() noexcept;
+    void unlockWriter_(std::uint64_t seq) noexcept;
+
+    alignas(64) std::atomic<std::uint64_t> seq_;
+    value_type value_;
+};
+
+
+/**
+ * @brief 双缓冲的顺序锁（latch），适合较大的 T。
+ *
+ * 维护两份副本：写者先把序号切到奇数，让读者去读副本 1，再改副本 0；
+ * 然后切回偶数，让读者读副本 0，再改副本 1。
+ * 读者总有一份不在修改中的副本可读，写入期间不会自旋等待；
+ * 只有在一次读取跨越了两次切换时才需要重试。
+ *
+ * 代价是写者要写两遍，写者之间用独立的锁字串行化。
+ *
+ * @tparam T 快照类型，必须可平凡拷贝
+ */
+template <class T>
+class ShmDoubleBufferedSeqlock {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "ShmDoubleBufferedSeqlock requires a trivially copyable value type");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                  "ShmDoubleBufferedSeqlock requires lock-free 64-bit atomics for shared memory");
+
+public:
+    using value_type = T;
+
+public:
+    ShmDoubleBufferedSeqlock() noexcept;
+    explicit ShmDoubleBufferedSeqlock(const value_type& init) noexcept;
+    ~ShmDoubleBufferedSeqlock() = default;
+
+    ShmDoubleBufferedSeqlock(const ShmDoubleBufferedSeqlock&) = delete;
+    ShmDoubleBufferedSeqlock& operator=(const ShmDoubleBufferedSeqlock&) = delete;
+    ShmDoubleBufferedSeqlock(ShmDoubleBufferedSeqlock&&) = delete;
+    ShmDoubleBufferedSeqlock& operator=(ShmDoubleBufferedSeqlock&&) = delete;
+
+    // --- 读者接口 ---
+    value_type load() const noexcept;
+    // 把快照直接拷到 out，避免大对象按值返回
+    void load(value_type& out) const noexcept;
+
+    // --- 写者接口 ---
+    void store(const value_type& v) noexcept;
+
+    // 每次完整写入序号加 2
+    std::uint64_t getSequence() const noexcept;
+
+private:
+    void lockWriter_() noexcept;
+    void unlockWriter_() noexcept;
+
+    alignas(64) std::atomic<std::uint64_t> seq_;
+    std::atomic<std::uint32_t> writer_lock_;
+
+    alignas(64) value_type copies_[2];
+};
+
+#include "ShmSeqlock_impl.hpp"
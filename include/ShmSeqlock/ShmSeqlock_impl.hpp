@@ -0,0 +1,178 @@
+#pragma once
+
+#include "ShmSeqlock.hpp"
+
+#include <cstring>
+
+namespace ShmSeqlockDetail {
+inline void cpuRelax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    asm volatile("pause" ::: "memory");
+#else
+    asm volatile("" ::: "memory");
+#endif
+}
+} // namespace ShmSeqlockDetail
+
+// ============================================================================
+// ShmSeqlock
+// ============================================================================
+
+template <class T>
+ShmSeqlock<T>::ShmSeqlock() noexcept : value_{} {
+    // 发布初始化结果
+    seq_.store(0, std::memory_order_release);
+}
+
+template <class T>
+ShmSeqlock<T>::ShmSeqlock(const value_type& init) noexcept : value_(init) {
+    seq_.store(0, std::memory_order_release);
+}
+
+template <class T>
+bool ShmSeqlock<T>::tryLoad(value_type& out) const noexcept {
+    const std::uint64_t before = seq_.load(std::memory_order_acquire);
+    if (before & 1u) {
+        return false; // 写入中
+    }
+
+    value_type tmp;
+    std::memcpy(&tmp, &value_, sizeof(value_type));
+
+    // 拷贝完成后再确认序号没有变化
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (seq_.load(std::memory_order_relaxed) != before) {
+        return false;
+    }
+    out = tmp;
+    return true;
+}
+
+template <class T>
+typename ShmSeqlock<T>::value_type ShmSeqlock<T>::load() const noexcept {
+    value_type out;
+    while (!tryLoad(out)) {
+        ShmSeqlockDetail::cpuRelax();
+    }
+    return out;
+}
+
+template <class T>
+void ShmSeqlock<T>::store(const value_type& v) noexcept {
+    const std::uint64_t seq = lockWriter_();
+    std::memcpy(&value_, &v, sizeof(value_type));
+    unlockWriter_(seq);
+}
+
+template <class T>
+template <class Fn>
+void ShmSeqlock<T>::update(Fn&& fn) noexcept(noexcept(fn(std::declval<value_type&>()))) {
+    const std::uint64_t seq = lockWriter_();
+    std::forward<Fn>(fn)(value_);
+    unlockWriter_(seq);
+}
+
+template <class T>
+std::uint64_t ShmSeqlock<T>::getSequence() const noexcept {
+    return seq_.load(std::memory_order_acquire);
+}
+
+template <class T>
+std::uint64_t ShmSeqlock<T>::lockWriter_() noexcept {
+    std::uint64_t seq = seq_.load(std::memory_order_relaxed);
+    for (;;) {
+        if ((seq & 1u) == 0 &&
+            seq_.compare_exchange_weak(seq, seq + 1,
+                                       std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+            break;
+        }
+        ShmSeqlockDetail::cpuRelax();
+        seq = seq_.load(std::memory_order_relaxed);
+    }
+    // 奇数序号必须先于数据写入对读者可见
+    std::atomic_thread_fence(std::memory_order_release);
+    return seq;
+}
+
+template <class T>
+void ShmSeqlock<T>::unlockWriter_(std::uint64_t seq) noexcept {
+    seq_.store(seq + 2, std::memory_order_release);
+}
+
+// ============================================================================
+// ShmDoubleBufferedSeqlock
+// ============================================================================
+
+template <class T>
+ShmDoubleBufferedSeqlock<T>::ShmDoubleBufferedSeqlock() noexcept : copies_{} {
+    writer_lock_.store(0, std::memory_order_relaxed);
+    seq_.store(0, std::memory_order_release);
+}
+
+template <class T>
+ShmDoubleBufferedSeqlock<T>::ShmDoubleBufferedSeqlock(const value_type& init) noexcept
+    : copies_{init, init} {
+    writer_lock_.store(0, std::memory_order_relaxed);
+    seq_.store(0, std::memory_order_release);
+}
+
+template <class T>
+void ShmDoubleBufferedSeqlock<T>::load(value_type& out) const noexcept {
+    for (;;) {
+        const std::uint64_t seq = seq_.load(std::memory_order_acquire);
+        // 偶数读副本 0，奇数读副本 1：读的总是写者此刻没在改的那一份
+        std::memcpy(&out, &copies_[seq & 1u], sizeof(value_type));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq_.load(std::memory_order_relaxed) == seq) {
+            return;
+        }
+    }
+}
+
+template <class T>
+typename ShmDoubleBufferedSeqlock<T>::value_type ShmDoubleBufferedSeqlock<T>::load() const noexcept {
+    value_type out;
+    load(out);
+    return out;
+}
+
+template <class T>
+void ShmDoubleBufferedSeqlock<T>::store(const value_type& v) noexcept {
+    lockWriter_();
+    const std::uint64_t seq = seq_.load(std::memory_order_relaxed);
+
+    // 1. 读者切到副本 1，然后改副本 0
+    seq_.store(seq + 1, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&copies_[0], &v, sizeof(value_type));
+
+    // 2. 读者切回副本 0，然后改副本 1
+    seq_.store(seq + 2, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&copies_[1], &v, sizeof(value_type));
+
+    unlockWriter_();
+}
+
+template <class T>
+std::uint64_t ShmDoubleBufferedSeqlock<T>::getSequence() const noexcept {
+    return seq_.load(std::memory_order_acquire);
+}
+
+template <class T>
+void ShmDoubleBufferedSeqlock<T>::lockWriter_() noexcept {
+    std::uint32_t expected = 0;
+    while (!writer_lock_.compare_exchange_weak(expected, 1,
+                                               std::memory_order_acquire,
+                                               std::memory_order_relaxed)) {
+        expected = 0;
+        ShmSeqlockDetail::cpuRelax();
+    }
+}
+
+template <class T>
+void ShmDoubleBufferedSeqlock<T>::unlockWriter_() noexcept {
+    writer_lock_.store(0, std::memory_order_release);
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <atomic>
+
+/**
+ * @class AsymmetricFence
+ * @brief 非对称内存屏障：读者走热路径，只用编译器屏障；回收者在扫描前用 membarrier 代为补上 StoreLoad 屏障。
+ *
+ * 典型用法是危险指针的 protect/validate 与回收者的“摘链 -> 扫描”：
+ *   读者：   hp.store(p); AsymmetricFence::light(); 重读源指针验证
+ *   回收者： 摘链;        AsymmetricFence::heavy(); 读取所有危险指针
+ *
+ * heavy() 使用 MEMBARRIER_CMD_GLOBAL_EXPEDITED：它也覆盖其他已注册的进程，
+ * 共享内存中的容器可以被多个进程同时使用。每个进程在第一次使用时注册，
+ * fork 出的子进程会重新注册。
+ * 内核不支持（或注册失败）时退化为对称模式：light() 与 heavy() 都是 seq_cst 屏障。
+ */
+class AsymmetricFence {
+public:
+    // 读者一侧：非对称模式下只阻止编译器重排
+    static void light() noexcept {
+        if (isExpedited()) {
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+        } else {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+
+    // 回收者一侧：让所有运行中的读者线程都执行一次完整的内存屏障
+    static void heavy() noexcept;
+
+    // 本进程是否工作在非对称模式（第一次调用时决定，之后不再改变）
+    static bool isExpedited() noexcept {
+        static const bool expedited = registerExpedited_();
+        return expedited;
+    }
+
+private:
+    static bool registerExpedited_() noexcept;
+};
@@ -0,0 +1,120 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * @class InstanceRegistry
+ * @brief 进程内的存活实例登记表，供“线程本地缓存 + 实例析构”的槽位管理器共用
+ *        （ThreadSlotManager、ShmEBRManager、HpSlotManager、ShmHazardOrganizer）。
+ *
+ * 线程本地缓存（InstanceLocalCache）按实例编号记录领取的槽位；线程退出时持 getMutex() 检查 isLive，
+ * 只向仍然存活的实例归还，实例析构前先 unregisterInstance，因此持锁期间不会被析构。
+ * 编号在进程内唯一且不复用，同一地址上先后构造的实例可以区分开。
+ * 登记表有意泄漏，保证主线程的 thread_local 析构时它依然有效。
+ *
+ * fork 出的子进程里 getForkGeneration 加一：继承来的线程本地槽位属于父进程，必须重新登记。
+ * 处理函数在第一次 registerInstance 时注册，早于任何实例被 fork 继承。
+ */
+class InstanceRegistry {
+public:
+    // 分配一个新编号并登记为存活
+    static std::uint64_t registerInstance();
+    static void unregisterInstance(std::uint64_t id);
+
+    // 检查并使用存活实例期间持有
+    static std::mutex& getMutex() noexcept;
+    // 调用方必须持有 getMutex()
+    static bool isLive(std::uint64_t id);
+
+    static std::uint64_t getForkGeneration() noexcept {
+        return fork_generation_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static void onForkChild_() noexcept;
+
+    static inline std::atomic<std::uint64_t> fork_generation_{0};
+};
+
+/**
+ * @class InstanceLocalCache
+ * @brief 槽位管理器共用的线程本地缓存：同一线程在每个 Manager 实例中各持有一份 Value（通常是槽位）。
+ *
+ * 用 (地址, 实例编号, fork 代数) 识别实例：新实例复用旧实例地址时拿不到失效的值，
+ * fork 出的子进程也不会沿用父进程登记的槽位。
+ * 线程退出时持 InstanceRegistry::getMutex()，只对本进程中仍然存活的实例调用 release 归还。
+ *
+ * 用法（管理器的成员函数内，无捕获的 lambda 可以访问私有成员）：
+ *   thread_local InstanceLocalCache<Manager, Slot*> cache(
+ *       [](Manager* manager, Slot*& slot) { manager->releaseSlot_(slot); });
+ */
+template <class Manager, class Value>
+class InstanceLocalCache {
+public:
+    using ReleaseFn = void (*)(Manager* manager, Value& value);
+
+    explicit InstanceLocalCache(ReleaseFn release) noexcept : release_(release) {}
+    ~InstanceLocalCache();
+
+    InstanceLocalCache(const InstanceLocalCache&) = delete;
+    InstanceLocalCache& operator=(const InstanceLocalCache&) = delete;
+
+    // 当前线程在该实例上的值，没有时返回 nullptr；指针在下一次 insert 前有效
+    Value* find(const Manager* manager, std::uint64_t instance_id) noexcept;
+    // 记录当前线程在该实例上的值
+    Value* insert(Manager* manager, std::uint64_t instance_id, const Value& value);
+
+private:
+    struct Entry {
+        Manager*      manager;
+        std::uint64_t instance_id;
+        std::uint64_t fork_generation;
+        Value         value;
+    };
+
+    ReleaseFn          release_;
+    std::vector<Entry> entries_;
+};
+
+
+template <class Manager, class Value>
+InstanceLocalCache<Manager, Value>::~InstanceLocalCache() {
+    const std::uint64_t generation = InstanceRegistry::getForkGeneration();
+    // 持锁归还：实例在此期间不会被析构
+    std::lock_guard<std::mutex> lock(InstanceRegistry::getMutex());
+    for (Entry& entry : entries_) {
+        if (entry.fork_generation == generation && InstanceRegistry::isLive(entry.instance_id)) {
+            release_(entry.manager, entry.value);
+        }
+    }
+}
+
+template <class Manager, class Value>
+Value* InstanceLocalCache<Manager, Value>::find(const Manager* manager, std::uint64_t instance_id) noexcept {
+    const std::uint64_t generation = InstanceRegistry::getForkGeneration();
+    for (Entry& entry : entries_) {
+        if (entry.manager == manager && entry.instance_id == instance_id &&
+            entry.fork_generation == generation) {
+            return &entry.value;
+        }
+    }
+    return nullptr;
+}
+
+template <class Manager, class Value>
+Value* InstanceLocalCache<Manager, Value>::insert(Manager* manager, std::uint64_t instance_id, const Value& value) {
+    const std::uint64_t generation = InstanceRegistry::getForkGeneration();
+    for (Entry& entry : entries_) {
+        // 同一地址上的旧实例已经销毁，或者是 fork 前父进程的登记：直接覆盖
+        if (entry.manager == manager) {
+            entry.instance_id     = instance_id;
+            entry.fork_generation = generation;
+            entry.value           = value;
+            return &entry.value;
+        }
+    }
+    entries_.push_back(Entry{manager, instance_id, generation, value});
+    return &entries_.back().value;
+}
@@ -0,0 +1,161 @@
+#pragma once
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <signal.h>
+#include <sys/types.h>
+
+/**
+ * @class PidSlotTable
+ * @brief 放在共享内存中、按持有者 PID 登记的固定大小槽位表，供 ShmEBRDomain 与 ShmHazardDomain 共用。
+ *
+ * 每个槽位是 owner_pid + 调用方的 Payload；owner_pid 为 0 表示空闲，kReapingPid 表示正在回收。
+ * 持有进程崩溃后，其他进程通过 kill(pid, 0) 发现并回收它的槽位：
+ * 先把持有者改成 kReapingPid 占住槽位，由调用方传入的 reap 回调清理 Payload，再交还为空闲，
+ * 这样既不会误清新持有者的状态，新持有者也看不到旧持有者留下的状态。
+ * （PID 被复用时只会让回收变得保守，不会不安全。）
+ *
+ * 表只初始化 owner_pid，Payload 由调用方初始化；对象不含进程相关的指针。
+ */
+template <class Payload, std::size_t N>
+class PidSlotTable {
+public:
+    static constexpr std::size_t kMaxSlots = N;
+    static constexpr std::int32_t kInvalidSlot = -1;
+
+    PidSlotTable() noexcept {
+        for (Slot& slot : slots_) {
+            slot.owner_pid.store(0, std::memory_order_relaxed);
+        }
+    }
+    ~PidSlotTable() = default;
+
+    PidSlotTable(const PidSlotTable&) = delete;
+    PidSlotTable& operator=(const PidSlotTable&) = delete;
+    PidSlotTable(PidSlotTable&&) = delete;
+    PidSlotTable& operator=(PidSlotTable&&) = delete;
+
+    // 为 pid 占用一个空闲槽位；没有空槽时先回收已死进程的槽位，仍然没有则返回 kInvalidSlot
+    template <class Reap>
+    std::int32_t acquire(pid_t pid, Reap reap) noexcept;
+    // 交还槽位；Payload 由持有者事先清理
+    void release(std::int32_t index) noexcept;
+
+    // 回收所有持有者已经退出的槽位，返回回收的数量
+    template <class Reap>
+    std::size_t reapDead(Reap reap) noexcept;
+    // 持有者仍为 expected_pid 时调用 reap(payload) 清理并释放槽位；返回是否由本次调用回收
+    template <class Reap>
+    bool reapSlot(std::int32_t index, pid_t expected_pid, Reap reap) noexcept;
+
+    pid_t getOwner(std::int32_t index) const noexcept;
+    std::size_t getUsedCount() const noexcept;
+
+    Payload& getPayload(std::int32_t index) noexcept { return slots_[index].payload; }
+    const Payload& getPayload(std::int32_t index) const noexcept { return slots_[index].payload; }
+
+    static bool isProcessAlive(pid_t pid) noexcept {
+        if (pid <= 0) {
+            return false;
+        }
+        // EPERM 说明进程存在，只是没有权限发信号
+        return ::kill(pid, 0) == 0 || errno == EPERM;
+    }
+
+private:
+    // 回收死进程槽位期间的临时持有者
+    static constexpr std::int32_t kReapingPid = -1;
+
+    struct alignas(64) Slot {
+        std::atomic<std::int32_t> owner_pid;
+        Payload                   payload;
+    };
+
+    static bool inRange_(std::int32_t index) noexcept {
+        return index >= 0 && static_cast<std::size_t>(index) < N;
+    }
+
+    Slot slots_[N];
+};
+
+
+template <class Payload, std::size_t N>
+template <class Reap>
+std::int32_t PidSlotTable<Payload, N>::acquire(pid_t pid, Reap reap) noexcept {
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        for (std::size_t i = 0; i < N; ++i) {
+            std::int32_t expected = 0;
+            if (slots_[i].owner_pid.load(std::memory_order_relaxed) == 0 &&
+                slots_[i].owner_pid.compare_exchange_strong(expected, pid,
+                                                            std::memory_order_acquire,
+                                                            std::memory_order_relaxed)) {
+                return static_cast<std::int32_t>(i);
+            }
+        }
+        // 槽位表满：清理崩溃进程留下的槽位后再试一次
+        if (reapDead(reap) == 0) {
+            break;
+        }
+    }
+    return kInvalidSlot;
+}
+
+template <class Payload, std::size_t N>
+void PidSlotTable<Payload, N>::release(std::int32_t index) noexcept {
+    if (!inRange_(index)) {
+        return;
+    }
+    slots_[index].owner_pid.store(0, std::memory_order_release);
+}
+
+template <class Payload, std::size_t N>
+template <class Reap>
+std::size_t PidSlotTable<Payload, N>::reapDead(Reap reap) noexcept {
+    std::size_t reaped = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+        const auto index = static_cast<std::int32_t>(i);
+        const pid_t owner = getOwner(index);
+        if (owner > 0 && !isProcessAlive(owner) && reapSlot(index, owner, reap)) {
+            ++reaped;
+        }
+    }
+    return reaped;
+}
+
+template <class Payload, std::size_t N>
+template <class Reap>
+bool PidSlotTable<Payload, N>::reapSlot(std::int32_t index, pid_t expected_pid, Reap reap) noexcept {
+    if (!inRange_(index) || expected_pid <= 0) {
+        return false; // 空闲，或者正在被其他进程回收
+    }
+    Slot& slot = slots_[index];
+    std::int32_t expected = expected_pid;
+    if (!slot.owner_pid.compare_exchange_strong(expected, kReapingPid,
+                                                std::memory_order_acquire,
+                                                std::memory_order_relaxed)) {
+        return false;
+    }
+    reap(slot.payload);
+    slot.owner_pid.store(0, std::memory_order_release);
+    return true;
+}
+
+template <class Payload, std::size_t N>
+pid_t PidSlotTable<Payload, N>::getOwner(std::int32_t index) const noexcept {
+    if (!inRange_(index)) {
+        return 0;
+    }
+    return slots_[index].owner_pid.load(std::memory_order_acquire);
+}
+
+template <class Payload, std::size_t N>
+std::size_t PidSlotTable<Payload, N>::getUsedCount() const noexcept {
+    std::size_t used = 0;
+    for (const Slot& slot : slots_) {
+        if (slot.owner_pid.load(std::memory_order_relaxed) != 0) {
+            ++used;
+        }
+    }
+    return used;
+}
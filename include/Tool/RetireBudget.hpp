@@ -0,0 +1,121 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+/**
+ * @class RetireBudget
+ * @brief 退休内存的计量与预算：记录已退休、尚未释放的节点数与字节数，超出预算时让 retire 同步帮忙回收或等待。
+ *
+ * 计数都是单调递增的总量，未释放量由差值得到，读取不需要遍历槽位。
+ * 回收路径只知道释放了多少个节点，字节数按退休节点的平均大小换算：
+ * 只管理一种节点的回收器得到的是精确值，混合多种节点时是估计值。
+ *
+ * 只包含原子变量，可以放在共享内存中由多个进程共用（见 ShmHazardDomain）。
+ *
+ * 用法（回收器的 retire 路径）：
+ *   budget.noteRetired(sizeof(T));
+ *   budget.enforce([&] { 回收一轮; });   // 未超出预算时只有两次读
+ * 回收路径释放节点后调用 noteReclaimed(count)。
+ */
+class RetireBudget {
+public:
+    RetireBudget() noexcept = default;
+    ~RetireBudget() = default;
+
+    RetireBudget(const RetireBudget&) = delete;
+    RetireBudget& operator=(const RetireBudget&) = delete;
+
+    // 0 表示不限。max_backpressure 为 0 时超出预算只同步回收一轮；
+    // 否则回收后仍超出预算的 retire 会让出 CPU、反复回收，至多等待这么久
+    void setLimits(std::size_t max_nodes, std::size_t max_bytes,
+                   std::chrono::nanoseconds max_backpressure = std::chrono::nanoseconds::zero()) noexcept {
+        max_nodes_.store(max_nodes, std::memory_order_relaxed);
+        max_bytes_.store(max_bytes, std::memory_order_relaxed);
+        max_backpressure_ns_.store(max_backpressure.count(), std::memory_order_relaxed);
+    }
+
+    std::size_t getMaxNodes() const noexcept { return max_nodes_.load(std::memory_order_relaxed); }
+    std::size_t getMaxBytes() const noexcept { return max_bytes_.load(std::memory_order_relaxed); }
+
+    void noteRetired(std::size_t bytes) noexcept {
+        retired_nodes_.fetch_add(1, std::memory_order_relaxed);
+        retired_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    void noteReclaimed(std::size_t nodes) noexcept {
+        if (nodes != 0) {
+            reclaimed_nodes_.fetch_add(nodes, std::memory_order_relaxed);
+        }
+    }
+
+    // 已退休、尚未释放的节点数
+    std::size_t getRetiredNodes() const noexcept {
+        // 先读释放数：两者都单调递增，差值不会为负
+        const std::uint64_t reclaimed = reclaimed_nodes_.load(std::memory_order_relaxed);
+        const std::uint64_t retired   = retired_nodes_.load(std::memory_order_relaxed);
+        return retired > reclaimed ? static_cast<std::size_t>(retired - reclaimed) : 0;
+    }
+
+    // 已退休、尚未释放的字节数
+    std::size_t getRetiredBytes() const noexcept {
+        const std::uint64_t reclaimed = reclaimed_nodes_.load(std::memory_order_relaxed);
+        const std::uint64_t retired   = retired_nodes_.load(std::memory_order_relaxed);
+        const std::uint64_t bytes     = retired_bytes_.load(std::memory_order_relaxed);
+        if (retired <= reclaimed) {
+            return 0;
+        }
+        return static_cast<std::size_t>(static_cast<double>(bytes) *
+                                        static_cast<double>(retired - reclaimed) /
+                                        static_cast<double>(retired));
+    }
+
+    bool isExceeded() const noexcept {
+        const std::size_t max_nodes = max_nodes_.load(std::memory_order_relaxed);
+        const std::size_t max_bytes = max_bytes_.load(std::memory_order_relaxed);
+        return (max_nodes != 0 && getRetiredNodes() > max_nodes) ||
+               (max_bytes != 0 && getRetiredBytes() > max_bytes);
+    }
+
+    // 帮忙回收、背压等待之后仍然超出预算的次数（读者停滞时会持续增长）
+    std::uint64_t getOverrunCount() const noexcept {
+        return overruns_.load(std::memory_order_relaxed);
+    }
+
+    // 超出预算时调用 reclaim 回收一轮；仍然超出且允许背压时，让出 CPU 后重试直到期限
+    template <class Reclaim>
+    void enforce(Reclaim&& reclaim) noexcept {
+        if (!isExceeded()) {
+            return;
+        }
+        reclaim();
+        if (!isExceeded()) {
+            return;
+        }
+        const std::int64_t wait_ns = max_backpressure_ns_.load(std::memory_order_relaxed);
+        if (wait_ns > 0) {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(wait_ns);
+            do {
+                std::this_thread::yield();
+                reclaim();
+                if (!isExceeded()) {
+                    return;
+                }
+            } while (std::chrono::steady_clock::now() < deadline);
+        }
+        overruns_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<std::size_t>  max_nodes_{0};
+    std::atomic<std::size_t>  max_bytes_{0};
+    std::atomic<std::int64_t> max_backpressure_ns_{0};
+    std::atomic<std::uint64_t> overruns_{0};
+
+    // 每次 retire 都会写入，独占缓存行
+    alignas(64) std::atomic<std::uint64_t> retired_nodes_{0};
+    std::atomic<std::uint64_t> retired_bytes_{0};
+    alignas(64) std::atomic<std::uint64_t> reclaimed_nodes_{0};
+};
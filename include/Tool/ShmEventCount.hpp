@@ -0,0 +1,94 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class ShmEventCount
+ * @brief 基于 futex 的事件计数器，给无锁容器的消费者提供“先自旋、再挂起”的阻塞等待。
+ *
+ * 对象只包含两个 32 位原子字，可以直接放在共享内存中跨进程使用
+ * （futex 不使用 FUTEX_PRIVATE_FLAG）。
+ *
+ * 用法（消费者）：
+ *   key = ec.prepareWait();        // 登记为等待者
+ *   if (条件已满足) { ec.cancelWait(); ... }
+ *   else ec.wait(key, timeout);    // 挂起，直到 notify 或超时
+ *
+ * 生产者在发布数据后调用 notifyOne()/notifyAll()：
+ * 没有等待者登记时只有一次内存屏障和一次读，不进入内核。
+ */
+class ShmEventCount {
+public:
+    using Key = std::uint32_t;
+
+    // 挂起前的自旋重试次数
+    static constexpr std::size_t kSpinBeforePark = 128;
+
+    ShmEventCount() noexcept;
+    ~ShmEventCount() = default;
+
+    ShmEventCount(const ShmEventCount&) = delete;
+    ShmEventCount& operator=(const ShmEventCount&) = delete;
+    ShmEventCount(ShmEventCount&&) = delete;
+    ShmEventCount& operator=(ShmEventCount&&) = delete;
+
+    Key  prepareWait() noexcept;
+    void cancelWait() noexcept;
+
+    // 挂起直到 key 之后有 notify（返回 true）或超时（返回 false）；
+    // 无论结果如何都会注销等待者登记。
+    bool wait(Key key, std::chrono::nanoseconds timeout) noexcept;
+
+    void notifyOne() noexcept;
+    void notifyAll() noexcept;
+
+    std::uint32_t getWaiterCount() const noexcept;
+
+    /**
+     * @brief 通用的“自旋 -> 挂起”等待循环。
+     * @param try_fn  无阻塞地尝试一次，成功返回 true（如 tryPop）
+     * @param timeout 最长等待时间
+     * @return try_fn 最终成功返回 true；超时返回 false
+     */
+    template <class TryFn>
+    bool await(TryFn&& try_fn, std::chrono::nanoseconds timeout);
+
+private:
+    static void cpuRelax_() noexcept;
+    void wake_(int count) noexcept;
+
+    alignas(64) std::atomic<std::uint32_t> epoch_;   // futex 字：每次有效 notify 加一
+    std::atomic<std::uint32_t> waiters_;             // 已登记的等待者数量
+};
+
+
+template <class TryFn>
+bool ShmEventCount::await(TryFn&& try_fn, std::chrono::nanoseconds timeout) {
+    // 1. 短暂自旋：数据通常很快到达，避免一次进出内核
+    for (std::size_t i = 0; i < kSpinBeforePark; ++i) {
+        if (try_fn()) return true;
+        cpuRelax_();
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (;;) {
+        // 2. 先登记再复查，保证不会错过 notify
+        Key key = prepareWait();
+        if (try_fn()) {
+            cancelWait();
+            return true;
+        }
+
+        auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::nanoseconds::zero()) {
+            cancelWait();
+            return false;
+        }
+
+        // 3. 挂起
+        wait(key, std::chrono::duration_cast<std::chrono::nanoseconds>(remaining));
+        if (try_fn()) return true;
+    }
+}
@@ -18,6 +18,9 @@ public:
     // 尾插块
     void appendUsed(BlockHeader* blk) noexcept;
 
+    // 把 other 的整条链接到尾部并清空 other（两者的游标都会失效，需重新 resetCursor）
+    void appendList(ManagedList& other) noexcept;
+
     // 从游标位置开始，摘除并返回下一个空闲块
     BlockHeader* reclaimNextFree() noexcept;
 
@@ -31,6 +31,9 @@ public:
     void* allocateBlock() noexcept;
     bool  releaseBlock(void* ptr) noexcept;
 
+    // 把 empty 链上的子池全部交还（线程退出时调用）；仍有在用块的子池保持不动
+    void releaseEmptyPools() noexcept;
+
     std::size_t getBlockSize()        const noexcept;
     std::size_t getPoolCountEmpty()   const noexcept;
     std::size_t getPoolCountPartial() const noexcept;
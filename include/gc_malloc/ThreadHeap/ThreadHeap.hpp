@@ -23,6 +23,7 @@ public:
     // --------------------- 对外公共接口 ---------------------
     static void*        allocate(std::size_t nbytes) noexcept;
     static void         deallocate(void* ptr) noexcept;
+    // 回收本线程已被释放的块，并顺带回收已退出线程遗留的块（见 reclaimOrphans_）
     static std::size_t  garbageCollect(std::size_t max_scan = SIZE_MAX) noexcept;
 
     ThreadHeap(const ThreadHeap&)            = delete;
@@ -46,6 +47,11 @@ private:
     void        attachUsed(BlockHeader* blk) noexcept;
     std::size_t reclaimBatch(std::size_t max_scan) noexcept;
 
+    // 线程退出时仍在用的块交给进程级的孤儿链表；
+    // 之后任意线程的 garbageCollect 把其中已释放的块还给所属子池，子池变空即交还 CentralHeap
+    void               orphanUsedBlocks_() noexcept;
+    static std::size_t reclaimOrphans_(std::size_t max_scan) noexcept;
+
 private:
     // 编译期常量（来自 SizeClassConfig.hpp，必须是 constexpr）
     static constexpr std::size_t k_class_count = SizeClassConfig::kClassCount;
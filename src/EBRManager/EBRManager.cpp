@@ -2,15 +2,34 @@
 #include "EBRManager/EBRManager.hpp"
 #include "EBRManager/ThreadSlot.hpp"
 
-EBRManager::EBRManager() {
+#include <mutex>
+#include <vector>
+
+EBRManager::EBRManager()
+    : background_reclaim_(false),
+      last_advance_ns_(nowNs_()), blocking_slot_(-1), blocking_slot_epoch_(0),
+      orphan_retired_(0), reclaimed_count_(0),
+      era_clock_(1), robust_mode_(false), stall_threshold_ns_(0),
+      robust_scan_mark_(0), robust_reclaimed_(0) {
     // 初始化全局纪元为0
     global_epoch_.store(0, std::memory_order_relaxed);
+    slot_manager_.setReleaseHook(&EBRManager::onSlotReleased_, this);
 }
 
 EBRManager::~EBRManager() {
+    slot_manager_.setReleaseHook(nullptr, nullptr);
+
+    // 析构时不应再有线程访问本管理器：所有槽位中的 limbo bag 都可以直接释放
+    slot_manager_.forEachSlot([](ThreadSlot& slot) {
+        for (size_t i = 0; i < ThreadSlot::kNumRetireBags; ++i) {
+            slot.getRetireBag(i).reclaimAll();
+        }
+    });
+
     for (size_t list_index = 0; list_index < kNumEpochLists; ++list_index) {
-        collectGarbage_(list_index);
+        garbage_collector_.collect(garbage_lists_[list_index].stealList());
     }
+    garbage_collector_.drain();
 }
 
 ThreadSlot* EBRManager::getLocalSlot_() {
@@ -21,6 +40,10 @@ void EBRManager::enter() {
     ThreadSlot* slot = getLocalSlot_();
     if (slot) {
         uint64_t current_epoch = global_epoch_.load(std::memory_order_relaxed);
+        if (slot->getNestDepth() == 0) {
+            // 保留区间随 enter 中的屏障一起发布
+            slot->reserveEra(era_clock_.load(std::memory_order_seq_cst));
+        }
         // 调用新的、单一的、原子化的方法
         slot->enter(current_epoch);
     }
@@ -32,23 +55,58 @@ void EBRManager::leave() {
     if (slot) {
         // 标记线程离开临界区（变为非活跃状态）
         slot->leave();
+        if (slot->getNestDepth() != 0) {
+            return; // 仍在外层临界区内，不能回收
+        }
+
+        if (background_reclaim_.load(std::memory_order_relaxed)) {
+            return; // 纪元推进与回收由后台线程负责
+        }
+        tryReclaim_(slot);
+    }
+}
 
-        if (tryAdvanceEpoch_()) {
-            uint64_t current_global_epoch = global_epoch_.load(std::memory_order_relaxed);
+void EBRManager::tryReclaim_(ThreadSlot* slot) {
+    // 先帮其他线程释放一块已经发布的垃圾：大批量回收由所有离开临界区的线程分摊
+    if (garbage_collector_.hasPending()) {
+        noteReclaimed_(garbage_collector_.help());
+    }
 
-            if (current_global_epoch >= 2) {
-                uint64_t epoch_to_collect = current_global_epoch - 2;
-                collectGarbage_(epoch_to_collect);
-            }
+    // 摊销：只有存在待回收垃圾时才每次尝试推进纪元，纯读路径每 kAdvanceInterval 次才扫描一次
+    const bool has_local_garbage = slot->hasPendingRetires();
+    if (!has_local_garbage && !hasGlobalGarbage_() &&
+        slot->bumpLeaveCount() % kAdvanceInterval != 0) {
+        return;
+    }
+
+    if (tryAdvanceEpoch_()) {
+        uint64_t current_global_epoch = global_epoch_.load(std::memory_order_relaxed);
+
+        if (current_global_epoch >= 2) {
+            uint64_t epoch_to_collect = current_global_epoch - 2;
+            collectGarbage_(epoch_to_collect);
         }
+    } else if (robust_mode_.load(std::memory_order_relaxed) && isStalled_() &&
+               pendingGarbage_() >= robust_scan_mark_.load(std::memory_order_relaxed) + kRobustScanInterval) {
+        // 纪元被卡住且垃圾仍在增长：改用区间规则回收
+        robustScan_(slot);
+    }
+
+    if (has_local_garbage) {
+        reclaimLocalBags_(slot, global_epoch_.load(std::memory_order_acquire));
     }
 }
 
 bool EBRManager::tryAdvanceEpoch_() {
     // 使用 acquire 内存序加载，确保我们能看到其他线程 leave 操作释放的最新状态
     uint64_t current_epoch = global_epoch_.load(std::memory_order_acquire);
-    
+
+    // 与 ThreadSlot::enter 中的屏障配对：扫描前已完成的摘链对随后进入的线程可见，
+    // 或者该线程的活跃标记能被下面的扫描看到
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
     bool can_advance = true;
+    int64_t slot_index = 0;
 
     // 遍历所有已注册的线程槽，检查是否有“掉队者”
     slot_manager_.forEachSlot([&](const ThreadSlot& slot) {
@@ -59,7 +117,12 @@ bool EBRManager::tryAdvanceEpoch_() {
         if (ThreadSlot::isActive(slot_state) && 
             ThreadSlot::unpackEpoch(slot_state) < current_epoch) {
             can_advance = false;
+            // 记下掉队者，供 getStats 诊断
+            blocking_slot_.store(slot_index, std::memory_order_relaxed);
+            blocking_slot_epoch_.store(ThreadSlot::unpackEpoch(slot_state), std::memory_order_relaxed);
+            return;
         }
+        ++slot_index;
     });
 
     if (!can_advance) {
@@ -67,20 +130,406 @@ bool EBRManager::tryAdvanceEpoch_() {
     }
 
     // 如果没有掉队者，尝试原子地将全局纪元加一
-    return global_epoch_.compare_exchange_strong(
-        current_epoch, 
-        current_epoch + 1,
-        std::memory_order_acq_rel,
-        std::memory_order_relaxed
-    );
+    if (!global_epoch_.compare_exchange_strong(
+            current_epoch,
+            current_epoch + 1,
+            std::memory_order_acq_rel,
+            std::memory_order_relaxed)) {
+        return false;
+    }
+    blocking_slot_.store(-1, std::memory_order_relaxed);
+    last_advance_ns_.store(nowNs_(), std::memory_order_relaxed);
+    return true;
 }
 
-void EBRManager::collectGarbage_(uint64_t epoch_to_collect) {
-    size_t list_index = epoch_to_collect % kNumEpochLists;
+bool EBRManager::hasGlobalGarbage_() const noexcept {
+    for (size_t i = 0; i < kNumEpochLists; ++i) {
+        if (!garbage_lists_[i].isEmpty()) {
+            return true;
+        }
+    }
+    return false;
+}
 
-    GarbageNode* garbage_head = garbage_lists_[list_index].stealList();
+void EBRManager::collectGarbage_(uint64_t epoch_to_collect) {
+    GarbageNode* garbage_head = stealCollectable_(epoch_to_collect);
 
     if (garbage_head) {
-        garbage_collector_.collect(garbage_head);
+        noteReclaimed_(garbage_collector_.collect(garbage_head));
+    }
+}
+
+GarbageNode* EBRManager::stealCollectable_(uint64_t epoch_to_collect) {
+    LockFreeSingleLinkedList& list = garbage_lists_[epoch_to_collect % kNumEpochLists];
+    GarbageNode* garbage_head = list.stealList();
+    if (!garbage_head) {
+        return nullptr;
+    }
+
+    // 摘链之前纪元又被推进过时，同一下标的链表里可能混入了纪元 epoch_to_collect + 3 的节点：
+    // 整条放回，留给下一次推进
+    if (global_epoch_.load(std::memory_order_acquire) != epoch_to_collect + 2) {
+        GarbageNode* tail = garbage_head;
+        while (tail->next) {
+            tail = tail->next;
+        }
+        list.pushChain(garbage_head, tail);
+        return nullptr;
+    }
+    return garbage_head;
+}
+
+void EBRManager::retireRaw_(void* ptr, void (*deleter)(void*)) {
+    // acquire：退休纪元不会比摘链时刻已经可见的全局纪元更旧
+    const uint64_t epoch = global_epoch_.load(std::memory_order_acquire);
+    const size_t index = epoch % kNumEpochLists;
+
+    ThreadSlot* slot = getLocalSlot_();
+    noteRetired_(slot);
+    if (!slot) {
+        pushGlobal_(index, ptr, deleter);
+        return;
+    }
+
+    RetireBag& bag = slot->getRetireBag(index);
+    if (!bag.isEmpty() && bag.getEpoch() != epoch) {
+        // 同一下标上的旧 bag 至少落后 3 个纪元，可以直接释放
+        recycleStaleBag_(slot, index);
+    }
+    if (bag.isFull()) {
+        flushRetireBag_(slot, index);
+        if (bag.isFull()) {
+            // 内存不足、bag 没能腾出空间时，这一项单独挂到全局链表
+            pushGlobal_(index, ptr, deleter);
+            return;
+        }
+    }
+    bag.push(epoch, ptr, deleter);
+}
+
+void EBRManager::retireHooked_(EBRHook* node) {
+    const uint64_t epoch = global_epoch_.load(std::memory_order_acquire);
+    const size_t index = epoch % kNumEpochLists;
+
+    ThreadSlot* slot = getLocalSlot_();
+    node->ebr_retire_era = noteRetired_(slot);
+    if (!slot) {
+        node->ebr_next = nullptr; // 单节点的钩子链
+        pushGlobal_(index, node, &EBRHook::reclaimChain);
+        return;
+    }
+
+    RetireBag& bag = slot->getRetireBag(index);
+    if (!bag.isEmpty() && bag.getEpoch() != epoch) {
+        recycleStaleBag_(slot, index);
+    }
+    bag.pushHooked(epoch, node);
+    if (bag.isHookedChainFull()) {
+        // 纪元迟迟不推进时，把整条链（只需一个 GarbageNode）交给全局链表
+        flushRetireBag_(slot, index);
+    }
+}
+
+void EBRManager::pushGlobal_(size_t index, void* ptr, void (*deleter)(void*)) {
+    void* gnode_mem = ThreadHeap::allocate(sizeof(GarbageNode));
+    if (!gnode_mem) {
+        return; // 无法安全释放，只能泄漏
+    }
+    GarbageNode* g_node = new(gnode_mem) GarbageNode(ptr, deleter);
+    garbage_lists_[index].pushNode(g_node);
+}
+
+bool EBRManager::flushRetireBag_(ThreadSlot* slot, size_t index) {
+    RetireBag& bag = slot->getRetireBag(index);
+    const uint64_t bag_epoch = bag.getEpoch();
+
+    // 在本地把 bag 的内容串成一条 GarbageNode 链，再一次 CAS 挂到它所属纪元的全局链表
+    GarbageNode* first = nullptr;
+    GarbageNode* last  = nullptr;
+    RetireBag::Entry entry;
+    while (bag.popBack(entry)) {
+        void* gnode_mem = ThreadHeap::allocate(sizeof(GarbageNode));
+        if (!gnode_mem) {
+            bag.push(bag_epoch, entry.ptr, entry.deleter); // 放回，留给之后直接释放
+            break;
+        }
+        GarbageNode* g_node = new(gnode_mem) GarbageNode(entry.ptr, entry.deleter);
+        g_node->next = first;
+        first = g_node;
+        if (!last) {
+            last = g_node;
+        }
+    }
+
+    // 侵入式链整体作为一个 GarbageNode，回收时由 EBRHook::reclaimChain 逐个释放
+    EBRHook* hooked_head = bag.takeHookedChain();
+    if (hooked_head) {
+        void* gnode_mem = ThreadHeap::allocate(sizeof(GarbageNode));
+        if (!gnode_mem) {
+            // 放回原链，留给之后直接释放
+            for (EBRHook* h = hooked_head; h != nullptr;) {
+                EBRHook* next = h->ebr_next;
+                bag.pushHooked(bag_epoch, h);
+                h = next;
+            }
+        } else {
+            GarbageNode* g_node = new(gnode_mem) GarbageNode(hooked_head, &EBRHook::reclaimChain);
+            g_node->next = first;
+            first = g_node;
+            if (!last) {
+                last = g_node;
+            }
+        }
+    }
+
+    if (first) {
+        garbage_lists_[bag_epoch % kNumEpochLists].pushChain(first, last);
+    }
+    return bag.isEmpty();
+}
+
+void EBRManager::reclaimLocalBags_(ThreadSlot* slot, uint64_t global_epoch) {
+    for (size_t i = 0; i < ThreadSlot::kNumRetireBags; ++i) {
+        RetireBag& bag = slot->getRetireBag(i);
+        // 与全局链表相同的规则：纪元 e 的垃圾在全局纪元到达 e + 2 后才安全
+        if (!bag.isEmpty() && bag.getEpoch() + 2 <= global_epoch) {
+            noteReclaimed_(bag.reclaimAll());
+        }
+    }
+}
+
+void EBRManager::recycleStaleBag_(ThreadSlot* slot, size_t index) {
+    // 挂到当前纪元的全局链表只会推迟回收，仍然安全；内存不足没能转交时退回就地释放
+    if (background_reclaim_.load(std::memory_order_relaxed) && flushRetireBag_(slot, index)) {
+        return;
     }
-}
\ No newline at end of file
+    noteReclaimed_(slot->getRetireBag(index).reclaimAll());
+}
+
+void EBRManager::setBackgroundReclaim(bool enabled) {
+    background_reclaim_.store(enabled, std::memory_order_relaxed);
+    if (!enabled) {
+        noteReclaimed_(garbage_collector_.drain());
+    }
+}
+
+bool EBRManager::isBackgroundReclaim() const noexcept {
+    return background_reclaim_.load(std::memory_order_relaxed);
+}
+
+size_t EBRManager::reclaimStep(size_t max_nodes) {
+    // 已发布的块处理完之前不再推进纪元；摘下的整条链只发布，不在这里释放，
+    // 多个回收线程随后各自取走一段
+    if (!garbage_collector_.hasPending() && tryAdvanceEpoch_()) {
+        const uint64_t current_global_epoch = global_epoch_.load(std::memory_order_acquire);
+        if (current_global_epoch >= 2) {
+            GarbageNode* garbage_head = stealCollectable_(current_global_epoch - 2);
+            if (garbage_head) {
+                noteReclaimed_(garbage_collector_.defer(garbage_head));
+            }
+        }
+    }
+    const size_t reclaimed = garbage_collector_.help(max_nodes);
+    noteReclaimed_(reclaimed);
+    return reclaimed;
+}
+
+void EBRManager::onSlotReleased_(void* self, ThreadSlot* slot) {
+    EBRManager* manager = static_cast<EBRManager*>(self);
+    // 退出的线程不再持有任何引用；QSBR 下仍在线的槽位必须下线，否则会永远阻塞纪元推进
+    slot->deactivate();
+    for (size_t i = 0; i < ThreadSlot::kNumRetireBags; ++i) {
+        if (!slot->getRetireBag(i).isEmpty()) {
+            // 失败时垃圾留在槽位上，由下一个持有者或管理器析构时处理
+            manager->flushRetireBag_(slot, i);
+        }
+    }
+}
+
+// --- 诊断 ---
+
+uint64_t EBRManager::nowNs_() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void EBRManager::chargeRetired_(size_t bytes) {
+    budget_.noteRetired(bytes);
+    budget_.enforce([this]() {
+        if (background_reclaim_.load(std::memory_order_relaxed)) {
+            reclaimStep(kBudgetHelpStep);
+            return;
+        }
+        // 在临界区内也是安全的：只会释放比本线程所在纪元早两个纪元的垃圾
+        ThreadSlot* slot = getLocalSlot_();
+        if (slot) {
+            tryReclaim_(slot);
+        }
+    });
+}
+
+uint64_t EBRManager::noteRetired_(ThreadSlot* slot) {
+    const uint64_t count = slot ? slot->noteRetired()
+                                : orphan_retired_.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (count % kEraInterval == 0) {
+        era_clock_.fetch_add(1, std::memory_order_seq_cst);
+    }
+    // 摘链之后读取：晚于这个纪年进入的线程不可能再读到该节点
+    return era_clock_.load(std::memory_order_seq_cst);
+}
+
+void EBRManager::noteReclaimed_(size_t count) noexcept {
+    if (count != 0) {
+        reclaimed_count_.fetch_add(count, std::memory_order_relaxed);
+        budget_.noteReclaimed(count);
+    }
+}
+
+uint64_t EBRManager::pendingGarbage_() const {
+    // 先读释放数：各计数都是单调的，这样得到的差值不会偏小到负数以下太多
+    const uint64_t reclaimed = reclaimed_count_.load(std::memory_order_relaxed);
+    uint64_t retired = orphan_retired_.load(std::memory_order_relaxed);
+    slot_manager_.forEachSlot([&](const ThreadSlot& slot) {
+        retired += slot.getRetiredCount();
+    });
+    return retired > reclaimed ? retired - reclaimed : 0;
+}
+
+bool EBRManager::isStalled_() const noexcept {
+    const uint64_t now = nowNs_();
+    const uint64_t last = last_advance_ns_.load(std::memory_order_relaxed);
+    return now > last &&
+           now - last >= static_cast<uint64_t>(stall_threshold_ns_.load(std::memory_order_relaxed));
+}
+
+EBRManager::Stats EBRManager::getStats() const {
+    Stats stats;
+    stats.global_epoch = global_epoch_.load(std::memory_order_acquire);
+    const uint64_t now = nowNs_();
+    const uint64_t last = last_advance_ns_.load(std::memory_order_relaxed);
+    stats.stalled_ns = now > last ? now - last : 0;
+    stats.blocking_slot = blocking_slot_.load(std::memory_order_relaxed);
+    stats.blocking_slot_epoch = stats.blocking_slot < 0
+                                    ? 0 : blocking_slot_epoch_.load(std::memory_order_relaxed);
+    stats.pending_garbage = pendingGarbage_();
+    stats.robust_reclaimed = robust_reclaimed_.load(std::memory_order_relaxed);
+    stats.retired_bytes = budget_.getRetiredBytes();
+    return stats;
+}
+
+// --- 退休内存预算 ---
+
+void EBRManager::setRetireBudget(size_t max_nodes, size_t max_bytes,
+                                 std::chrono::nanoseconds max_backpressure) noexcept {
+    budget_.setLimits(max_nodes, max_bytes, max_backpressure);
+}
+
+size_t EBRManager::getRetiredBytes() const noexcept {
+    return budget_.getRetiredBytes();
+}
+
+uint64_t EBRManager::getBudgetOverrunCount() const noexcept {
+    return budget_.getOverrunCount();
+}
+
+// --- 健壮模式 ---
+
+void EBRManager::setRobustMode(bool enabled, std::chrono::nanoseconds stall_threshold) {
+    stall_threshold_ns_.store(stall_threshold.count(), std::memory_order_relaxed);
+    robust_mode_.store(enabled, std::memory_order_relaxed);
+}
+
+bool EBRManager::isRobustMode() const noexcept {
+    return robust_mode_.load(std::memory_order_relaxed);
+}
+
+void EBRManager::stampBirth(EBRHook* node) noexcept {
+    node->ebr_birth_era = era_clock_.load(std::memory_order_relaxed);
+}
+
+void EBRManager::robustScan_(ThreadSlot* slot) {
+    std::unique_lock<ShmMutexLock> lock(robust_lock_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return; // 已经有线程在扫描
+    }
+
+    // 与 enter / protectedLoad 中的屏障配对：要么看到读者的保留区间，要么读者看不到已摘下的节点
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    struct Reservation { uint64_t lower; uint64_t upper; };
+    std::vector<Reservation> reservations;
+    slot_manager_.forEachSlot([&](const ThreadSlot& s) {
+        if (ThreadSlot::isActive(s.loadState())) {
+            reservations.push_back({s.loadReservedLower(), s.loadReservedUpper()});
+        }
+    });
+    auto isReserved = [&](const EBRHook* node) {
+        for (const Reservation& r : reservations) {
+            if (node->ebr_birth_era <= r.upper && node->ebr_retire_era >= r.lower) {
+                return true;
+            }
+        }
+        return false;
+    };
+    // 释放没有任何保留区间覆盖的节点，返回剩下的链
+    size_t freed = 0;
+    auto filterChain = [&](EBRHook* head) {
+        EBRHook* kept = nullptr;
+        while (head) {
+            EBRHook* next = head->ebr_next;
+            if (isReserved(head)) {
+                head->ebr_next = kept;
+                kept = head;
+            } else {
+                head->ebr_deleter(head);
+                ++freed;
+            }
+            head = next;
+        }
+        return kept;
+    };
+
+    for (size_t list_index = 0; list_index < kNumEpochLists; ++list_index) {
+        GarbageNode* first = nullptr;
+        GarbageNode* last  = nullptr;
+        for (GarbageNode* g_node = garbage_lists_[list_index].stealList(); g_node != nullptr;) {
+            GarbageNode* next = g_node->next;
+            g_node->next = nullptr;
+            if (g_node->deleter == &EBRHook::reclaimChain) {
+                g_node->garbage_ptr = filterChain(static_cast<EBRHook*>(g_node->garbage_ptr));
+                if (!g_node->garbage_ptr) {
+                    g_node->~GarbageNode();
+                    ThreadHeap::deallocate(g_node);
+                    g_node = next;
+                    continue;
+                }
+            }
+            // 普通指针没有纪年信息，原样放回，等纪元推进
+            if (!first) {
+                first = g_node;
+            } else {
+                last->next = g_node;
+            }
+            last = g_node;
+            g_node = next;
+        }
+        // 放回同一下标：只会推迟回收，不会提前
+        if (first) {
+            garbage_lists_[list_index].pushChain(first, last);
+        }
+    }
+
+    // 本线程 bag 中的钩子链
+    for (size_t i = 0; i < ThreadSlot::kNumRetireBags; ++i) {
+        RetireBag& bag = slot->getRetireBag(i);
+        const uint64_t bag_epoch = bag.getEpoch();
+        for (EBRHook* h = filterChain(bag.takeHookedChain()); h != nullptr;) {
+            EBRHook* next = h->ebr_next;
+            bag.pushHooked(bag_epoch, h);
+            h = next;
+        }
+    }
+
+    noteReclaimed_(freed);
+    robust_reclaimed_.fetch_add(freed, std::memory_order_relaxed);
+    robust_scan_mark_.store(pendingGarbage_(), std::memory_order_relaxed);
+}
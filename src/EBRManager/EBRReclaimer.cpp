@@ -0,0 +1,67 @@
+// EBRReclaimer.cpp
+#include "EBRManager/EBRReclaimer.hpp"
+
+EBRReclaimer::EBRReclaimer(EBRManager& manager,
+                           size_t num_threads,
+                           size_t batch_size,
+                           std::chrono::microseconds idle_interval)
+    : manager_(manager),
+      batch_size_(batch_size),
+      idle_interval_(idle_interval),
+      reclaimed_count_(0),
+      stopping_(false) {
+    manager_.setBackgroundReclaim(true);
+
+    if (num_threads == 0) {
+        num_threads = 1;
+    }
+    threads_.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        threads_.emplace_back(&EBRReclaimer::run_, this);
+    }
+}
+
+EBRReclaimer::~EBRReclaimer() {
+    stop();
+}
+
+void EBRReclaimer::stop() {
+    {
+        std::lock_guard<std::mutex> lock(wait_mutex_);
+        if (stopping_) {
+            return;
+        }
+        stopping_ = true;
+    }
+    wait_cv_.notify_all();
+
+    for (auto& t : threads_) {
+        t.join();
+    }
+    threads_.clear();
+
+    // 切回就地回收，顺带释放还没处理完的批次
+    manager_.setBackgroundReclaim(false);
+}
+
+uint64_t EBRReclaimer::getReclaimedCount() const noexcept {
+    return reclaimed_count_.load(std::memory_order_relaxed);
+}
+
+void EBRReclaimer::run_() {
+    for (;;) {
+        const size_t reclaimed = manager_.reclaimStep(batch_size_);
+        if (reclaimed != 0) {
+            reclaimed_count_.fetch_add(reclaimed, std::memory_order_relaxed);
+        }
+
+        std::unique_lock<std::mutex> lock(wait_mutex_);
+        if (stopping_) {
+            return;
+        }
+        if (reclaimed == 0) {
+            // 没有可回收的垃圾（或纪元推进不了）时休眠，避免空转
+            wait_cv_.wait_for(lock, idle_interval_, [this]() { return stopping_; });
+        }
+    }
+}
@@ -21,6 +21,22 @@ void LockFreeSingleLinkedList::pushNode(Node* new_node) {
     }
 }
 
+void LockFreeSingleLinkedList::pushChain(Node* first, Node* last) {
+    for (;;) {
+        uint64_t old_packed = head_.load(std::memory_order_relaxed);
+        last->next = Packer::unpackPtr(old_packed);
+
+        uint16_t old_stamp = Packer::unpackStamp(old_packed);
+        uint64_t new_packed = Packer::pack(first, old_stamp + 1);
+
+        if (head_.compare_exchange_weak(old_packed, new_packed,
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
 LockFreeSingleLinkedList::Node* LockFreeSingleLinkedList::stealList() noexcept {
     for(;;) {
         uint64_t old_packed = head_.load(std::memory_order_acquire);
@@ -40,3 +56,7 @@ LockFreeSingleLinkedList::Node* LockFreeSingleLinkedList::stealList() noexcept {
         }
     }
 }
+
+bool LockFreeSingleLinkedList::isEmpty() const noexcept {
+    return Packer::unpackPtr(head_.load(std::memory_order_relaxed)) == nullptr;
+}
@@ -0,0 +1,41 @@
+// QSBRManager.cpp
+#include "EBRManager/QSBRManager.hpp"
+
+void QSBRManager::enter() {
+    ThreadSlot* slot = getLocalSlot_();
+    // 已在线时只有一次本地读，不写共享内存
+    if (slot && !ThreadSlot::isActive(slot->loadState())) {
+        slot->activate(global_epoch_.load(std::memory_order_acquire));
+    }
+}
+
+void QSBRManager::quiescent() {
+    ThreadSlot* slot = getLocalSlot_();
+    if (!slot) {
+        return;
+    }
+
+    // 观察当前纪元：之前读到的所有节点都不再被本线程引用
+    const uint64_t current_epoch = global_epoch_.load(std::memory_order_acquire);
+    if (ThreadSlot::isActive(slot->loadState())) {
+        slot->setEpoch(current_epoch);
+    } else {
+        slot->activate(current_epoch);
+    }
+
+    tryReclaim_(slot);
+}
+
+void QSBRManager::online() {
+    ThreadSlot* slot = getLocalSlot_();
+    if (slot) {
+        slot->activate(global_epoch_.load(std::memory_order_acquire));
+    }
+}
+
+void QSBRManager::offline() {
+    ThreadSlot* slot = getLocalSlot_();
+    if (slot) {
+        slot->deactivate();
+    }
+}
@@ -0,0 +1,54 @@
+// RetireBag.cpp
+#include "EBRManager/RetireBag.hpp"
+
+RetireBag::RetireBag() noexcept
+    : epoch_(0), count_(0),
+      hooked_head_(nullptr), hooked_count_(0) {}
+
+RetireBag::~RetireBag() {
+    reclaimAll();
+}
+
+void RetireBag::push(uint64_t epoch, void* ptr, void (*deleter)(void*)) noexcept {
+    if (isEmpty()) {
+        epoch_ = epoch;
+    }
+    entries_[count_].ptr     = ptr;
+    entries_[count_].deleter = deleter;
+    ++count_;
+}
+
+void RetireBag::pushHooked(uint64_t epoch, EBRHook* node) noexcept {
+    if (isEmpty()) {
+        epoch_ = epoch;
+    }
+    node->ebr_next = hooked_head_;
+    hooked_head_   = node;
+    ++hooked_count_;
+}
+
+EBRHook* RetireBag::takeHookedChain() noexcept {
+    EBRHook* head = hooked_head_;
+    hooked_head_  = nullptr;
+    hooked_count_ = 0;
+    return head;
+}
+
+bool RetireBag::popBack(Entry& out) noexcept {
+    if (count_ == 0) {
+        return false;
+    }
+    out = entries_[--count_];
+    return true;
+}
+
+std::size_t RetireBag::reclaimAll() noexcept {
+    const std::size_t reclaimed = count_ + hooked_count_;
+    for (std::size_t i = 0; i < count_; ++i) {
+        entries_[i].deleter(entries_[i].ptr);
+    }
+    count_ = 0;
+
+    EBRHook::reclaimChain(takeHookedChain());
+    return reclaimed;
+}
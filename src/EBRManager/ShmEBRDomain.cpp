@@ -0,0 +1,78 @@
+// ShmEBRDomain.cpp
+#include "EBRManager/ShmEBRDomain.hpp"
+
+ShmEBRDomain::ShmEBRDomain() noexcept {
+    for (size_t i = 0; i < kMaxSlots; ++i) {
+        slots_.getPayload(static_cast<int32_t>(i)).store(0, std::memory_order_relaxed);
+    }
+    // 发布初始化结果
+    global_epoch_.store(0, std::memory_order_release);
+}
+
+int32_t ShmEBRDomain::acquireSlot(pid_t pid) noexcept {
+    const int32_t index = slots_.acquire(pid, &ShmEBRDomain::clearState_);
+    if (index != kInvalidSlot) {
+        slots_.getPayload(index).store(0, std::memory_order_relaxed);
+    }
+    return index;
+}
+
+void ShmEBRDomain::releaseSlot(int32_t index) noexcept {
+    if (index < 0 || static_cast<size_t>(index) >= kMaxSlots) {
+        return;
+    }
+    slots_.getPayload(index).store(0, std::memory_order_release);
+    slots_.release(index);
+}
+
+void ShmEBRDomain::enter(int32_t index) noexcept {
+    const uint64_t epoch = global_epoch_.load(std::memory_order_relaxed);
+    slots_.getPayload(index).store((epoch << 1) | kActiveBit, std::memory_order_relaxed);
+    // 与 tryAdvanceEpoch 扫描前的屏障配对（见 ThreadSlot::activate）
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+void ShmEBRDomain::leave(int32_t index) noexcept {
+    std::atomic<uint64_t>& state = slots_.getPayload(index);
+    state.store(state.load(std::memory_order_relaxed) & ~kActiveBit, std::memory_order_release);
+}
+
+uint64_t ShmEBRDomain::getEpoch() const noexcept {
+    return global_epoch_.load(std::memory_order_acquire);
+}
+
+bool ShmEBRDomain::tryAdvanceEpoch() noexcept {
+    uint64_t current_epoch = global_epoch_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    for (size_t i = 0; i < kMaxSlots; ++i) {
+        const auto index = static_cast<int32_t>(i);
+        const uint64_t state = slots_.getPayload(index).load(std::memory_order_acquire);
+        if ((state & kActiveBit) == 0 || (state >> 1) >= current_epoch) {
+            continue;
+        }
+
+        // 掉队者：只有持有进程已经不存在（或槽位正在被回收）时才能跳过它
+        const pid_t owner = slots_.getOwner(index);
+        if (owner > 0 && SlotTable::isProcessAlive(owner)) {
+            return false;
+        }
+        slots_.reapSlot(index, owner, &ShmEBRDomain::clearState_);
+    }
+
+    return global_epoch_.compare_exchange_strong(current_epoch, current_epoch + 1,
+                                                 std::memory_order_acq_rel,
+                                                 std::memory_order_relaxed);
+}
+
+size_t ShmEBRDomain::reapDeadSlots() noexcept {
+    return slots_.reapDead(&ShmEBRDomain::clearState_);
+}
+
+pid_t ShmEBRDomain::getSlotOwner(int32_t index) const noexcept {
+    return slots_.getOwner(index);
+}
+
+size_t ShmEBRDomain::getUsedSlotCount() const noexcept {
+    return slots_.getUsedCount();
+}
@@ -0,0 +1,134 @@
+// ShmEBRManager.cpp
+#include "EBRManager/ShmEBRManager.hpp"
+
+#include <new>
+#include <unistd.h>
+
+#include "Tool/InstanceRegistry.hpp"
+
+ShmEBRManager::ShmEBRManager(ShmEBRDomain& domain)
+    : domain_(domain),
+      instance_id_(InstanceRegistry::registerInstance()),
+      last_collected_epoch_(0) {
+    for (size_t i = 0; i < ShmEBRDomain::kMaxSlots; ++i) {
+        owned_slots_[i].store(false, std::memory_order_relaxed);
+    }
+}
+
+ShmEBRManager::~ShmEBRManager() {
+    InstanceRegistry::unregisterInstance(instance_id_);
+
+    for (size_t i = 0; i < ShmEBRDomain::kMaxSlots; ++i) {
+        if (owned_slots_[i].exchange(false, std::memory_order_acq_rel)) {
+            domain_.releaseSlot(static_cast<int32_t>(i));
+        }
+    }
+
+    // 其他进程仍可能在读本进程退休的节点：只在纪元真正推进之后释放
+    for (size_t i = 0; i <= kNumEpochLists && hasGarbage_(); ++i) {
+        domain_.tryAdvanceEpoch();
+        collect_(domain_.getEpoch());
+    }
+}
+
+void ShmEBRManager::enter() {
+    LocalState* state = getLocalState_();
+    if (state && state->nest_depth++ == 0) {
+        domain_.enter(state->slot_index);
+    }
+}
+
+void ShmEBRManager::leave() {
+    LocalState* state = getLocalState_();
+    if (!state || state->nest_depth == 0 || --state->nest_depth != 0) {
+        return;
+    }
+    domain_.leave(state->slot_index);
+
+    // 顺手释放一块已经发布、早已过了宽限期的垃圾
+    garbage_collector_.help();
+
+    // 摊销：没有待回收垃圾时每 kAdvanceInterval 次才推进一次纪元
+    if (!hasGarbage_() && ++state->leave_count % kAdvanceInterval != 0) {
+        return;
+    }
+    domain_.tryAdvanceEpoch();
+    collect_(domain_.getEpoch());
+}
+
+ShmEBRManager::LocalState* ShmEBRManager::getLocalState_() {
+    // 同一线程在每个实例中各持有一个槽位；fork 后的子进程会重新登记
+    thread_local InstanceLocalCache<ShmEBRManager, LocalState> g_local_states(
+        [](ShmEBRManager* manager, LocalState& state) { manager->releaseSlot_(state.slot_index); });
+
+    LocalState* state = g_local_states.find(this, instance_id_);
+    if (!state) {
+        const int32_t slot_index = domain_.acquireSlot(::getpid());
+        if (slot_index == ShmEBRDomain::kInvalidSlot) {
+            return nullptr;
+        }
+        owned_slots_[slot_index].store(true, std::memory_order_release);
+        state = g_local_states.insert(this, instance_id_, LocalState{slot_index, 0, 0});
+    }
+    return state;
+}
+
+void ShmEBRManager::releaseSlot_(int32_t slot_index) noexcept {
+    // 与析构竞争时只由一方归还
+    if (owned_slots_[slot_index].exchange(false, std::memory_order_acq_rel)) {
+        domain_.releaseSlot(slot_index);
+    }
+}
+
+void ShmEBRManager::retireRaw_(void* ptr, void (*deleter)(void*)) {
+    void* gnode_mem = ThreadHeap::allocate(sizeof(GarbageNode));
+    if (!gnode_mem) {
+        return; // 无法安全释放，只能泄漏
+    }
+    GarbageNode* g_node = new(gnode_mem) GarbageNode(ptr, deleter);
+
+    const uint64_t epoch = domain_.getEpoch();
+    garbage_lists_[epoch % kNumEpochLists].pushNode(g_node);
+}
+
+bool ShmEBRManager::hasGarbage_() const noexcept {
+    for (size_t i = 0; i < kNumEpochLists; ++i) {
+        if (!garbage_lists_[i].isEmpty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ShmEBRManager::collect_(uint64_t global_epoch) {
+    if (global_epoch < 2) {
+        return;
+    }
+
+    // 纪元可能由其他进程推进：每个纪元只由一个线程回收一次
+    uint64_t last = last_collected_epoch_.load(std::memory_order_relaxed);
+    do {
+        if (last >= global_epoch) {
+            return;
+        }
+    } while (!last_collected_epoch_.compare_exchange_weak(last, global_epoch,
+                                                          std::memory_order_acq_rel,
+                                                          std::memory_order_relaxed));
+
+    LockFreeSingleLinkedList& list = garbage_lists_[(global_epoch - 2) % kNumEpochLists];
+    GarbageNode* garbage_head = list.stealList();
+    if (!garbage_head) {
+        return;
+    }
+
+    // 摘链之前纪元又被推进过时，链表里可能混入了纪元 global_epoch + 1 的节点：整条放回，下次再回收
+    if (domain_.getEpoch() != global_epoch) {
+        GarbageNode* tail = garbage_head;
+        while (tail->next) {
+            tail = tail->next;
+        }
+        list.pushChain(garbage_head, tail);
+        return;
+    }
+    garbage_collector_.collect(garbage_head);
+}
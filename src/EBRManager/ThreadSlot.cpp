@@ -2,7 +2,8 @@
 
 // --- 构造函数实现 ---
 ThreadSlot::ThreadSlot() noexcept
-    : next(nullptr) {
+    : next(nullptr), leave_count_(0), nest_depth_(0),
+      retired_count_(0), reserved_lower_(0), reserved_upper_(0) {
     // 初始状态：全零 (纪元0, 不活跃, 未被注册)。
     state_.store(pack_(0, false, false), std::memory_order_relaxed);
 }
@@ -41,67 +42,69 @@ void ThreadSlot::unregister() noexcept {
 }
 
 void ThreadSlot::enter(uint64_t current_epoch) noexcept {
-    // 这个方法原子地更新纪元并将线程标记为活跃。
-    // 我们也在这里处理“注册”的逻辑。
-    uint64_t old_state = state_.load(std::memory_order_relaxed);
-    for (;;) {
-        // 如果已经活跃，则什么都不做
-        if (isActive(old_state)) {
-            return;
-        }
-
-        // 打包新的状态：使用传入的纪元，并标记为 active 和 registered。
-        uint64_t new_state = pack_(current_epoch, true, true); 
-
-        if (state_.compare_exchange_weak(old_state, new_state,
-                                          std::memory_order_release,
-                                          std::memory_order_relaxed)) {
-            return;
-        }
+    // 内层 enter：外层已经让本线程处于活跃状态
+    if (nest_depth_++ != 0) {
+        return;
     }
+    activate(current_epoch);
 }
 
 void ThreadSlot::leave() noexcept {
-    uint64_t old_state = state_.load(std::memory_order_relaxed);
-    for (;;) {
-        // 只有已注册且活跃的线程才能离开
-        if (!isRegistered(old_state) || !isActive(old_state)) {
-            // 如果已经不活跃，或槽位不再属于我们，则不做任何事
-            return;
-        }
+    // 不成对的 leave 直接忽略；内层 leave 不能让线程变为不活跃
+    if (nest_depth_ == 0 || --nest_depth_ != 0) {
+        return;
+    }
+    deactivate();
+}
 
-        uint64_t epoch = unpackEpoch(old_state);
-        uint64_t new_state = pack_(epoch, false, true);
+void ThreadSlot::activate(uint64_t current_epoch) noexcept {
+    // state_ 只由槽位持有者写入，读自己的状态不需要同步
+    const uint64_t old_state = state_.load(std::memory_order_relaxed);
+    // 如果已经活跃，则什么都不做
+    if (isActive(old_state)) {
+        return;
+    }
 
-        if (state_.compare_exchange_weak(old_state, new_state,
-                                          std::memory_order_release,
-                                          std::memory_order_relaxed)) {
-            return;
-        }
+    // 打包新的状态：使用传入的纪元，并标记为 active 和 registered。
+    state_.store(pack_(current_epoch, true, true), std::memory_order_relaxed);
+    // 活跃标记必须先于临界区内的读操作对扫描者可见（store-load 屏障），
+    // 与 EBRManager::tryAdvanceEpoch_ 扫描前的屏障配对
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+void ThreadSlot::deactivate() noexcept {
+    nest_depth_ = 0;
+
+    const uint64_t old_state = state_.load(std::memory_order_relaxed);
+    // 只有已注册且活跃的线程才能离开
+    if (!isRegistered(old_state) || !isActive(old_state)) {
+        return;
     }
+    // release：临界区内的读操作先于“不活跃”对扫描者可见
+    state_.store(pack_(unpackEpoch(old_state), false, true), std::memory_order_release);
 }
-// --- 结束新增 ---
 
 void ThreadSlot::setEpoch(uint64_t newEpoch) noexcept {
-    uint64_t old_state = state_.load(std::memory_order_relaxed);
-    for (;;) {
-        if (!isRegistered(old_state)) {
-            return;
-        }
-        bool active = isActive(old_state);
-        uint64_t new_state = pack_(newEpoch, active, true);
-        if (state_.compare_exchange_weak(old_state, new_state,
-                                          std::memory_order_release,
-                                          std::memory_order_relaxed)) {
-            return;
-        }
+    const uint64_t old_state = state_.load(std::memory_order_relaxed);
+    if (!isRegistered(old_state)) {
+        return;
     }
+    state_.store(pack_(newEpoch, isActive(old_state), true), std::memory_order_release);
 }
 
 uint64_t ThreadSlot::loadState() const noexcept {
     return state_.load(std::memory_order_acquire);
 }
 
+bool ThreadSlot::hasPendingRetires() const noexcept {
+    for (size_t i = 0; i < kNumRetireBags; ++i) {
+        if (!retire_bags_[i].isEmpty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 // --- 静态辅助函数实现 ---
 uint64_t ThreadSlot::unpackEpoch(uint64_t state) noexcept {
     return state >> kEpochShift;
@@ -121,4 +124,27 @@ uint64_t ThreadSlot::pack_(uint64_t epoch, bool active, bool registered) noexcep
     if (active)     state |= kActiveBit;
     if (registered) state |= kRegisteredBit;
     return state;
-}
\ No newline at end of file
+}
+
+// --- 统计与健壮模式 ---
+uint64_t ThreadSlot::noteRetired() noexcept {
+    // 只有持有者写，不需要 RMW
+    const uint64_t count = retired_count_.load(std::memory_order_relaxed) + 1;
+    retired_count_.store(count, std::memory_order_relaxed);
+    return count;
+}
+
+void ThreadSlot::reserveEra(uint64_t era) noexcept {
+    reserved_lower_.store(era, std::memory_order_relaxed);
+    reserved_upper_.store(era, std::memory_order_relaxed);
+}
+
+bool ThreadSlot::extendReservation(uint64_t era) noexcept {
+    if (reserved_upper_.load(std::memory_order_relaxed) >= era) {
+        return true;
+    }
+    reserved_upper_.store(era, std::memory_order_relaxed);
+    // 新的上界必须先于随后的指针读取对扫描者可见，与 EBRManager::robustScan_ 的屏障配对
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return false;
+}
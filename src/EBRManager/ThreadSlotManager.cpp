@@ -3,29 +3,61 @@
 #include <new>
 #include <mutex>
 #include <cstring>
+#include "Tool/InstanceRegistry.hpp"
 
 ThreadSlotManager::ThreadSlotManager()
-    : capacity_(0) {}
+    : segment_count_(0),
+      capacity_(0),
+      instance_id_(InstanceRegistry::registerInstance()),
+      release_hook_(nullptr),
+      release_hook_context_(nullptr) {
+    for (size_t s = 0; s < kMaxSegments; ++s) {
+        segments_[s].slots.store(nullptr, std::memory_order_relaxed);
+        segments_[s].count = 0;
+    }
+}
+
+ThreadSlotManager::~ThreadSlotManager() {
+    InstanceRegistry::unregisterInstance(instance_id_);
+
+    const size_t segment_count = segment_count_.load(std::memory_order_acquire);
+    for (size_t s = 0; s < segment_count; ++s) {
+        ThreadSlot* slots_array = segments_[s].slots.load(std::memory_order_relaxed);
+        for (size_t i = segments_[s].count; i > 0; --i) {
+            slots_array[i - 1].~ThreadSlot();
+        }
+        ThreadHeap::deallocate(slots_array);
+    }
+}
 
-ThreadSlotManager::~ThreadSlotManager() {}
+void ThreadSlotManager::setReleaseHook(SlotReleaseHook hook, void* context) noexcept {
+    release_hook_context_ = context;
+    release_hook_ = hook;
+}
 
 
 ThreadSlot* ThreadSlotManager::getLocalSlot() {
 
-    thread_local LocalSlotProxy g_local_slot_proxy;
+    // 同一线程在每个 ThreadSlotManager 实例中各持有一个槽位
+    thread_local InstanceLocalCache<ThreadSlotManager, ThreadSlot*> g_local_slots(
+        [](ThreadSlotManager* manager, ThreadSlot*& slot) { manager->releaseSlot_(slot); });
 
-    if(!g_local_slot_proxy.hasSlot()) {
-        ThreadSlot* new_slot = acquireSlot_();
-        if(!new_slot) {
-            return nullptr;
-        }
-        g_local_slot_proxy.acquire(this, new_slot);
+    ThreadSlot** cached = g_local_slots.find(this, instance_id_);
+    if(cached) {
+        return *cached;
     }
-
-    return g_local_slot_proxy.get();
+    ThreadSlot* slot = acquireSlot_();
+    if(!slot) {
+        return nullptr;
+    }
+    g_local_slots.insert(this, instance_id_, slot);
+    return slot;
 }
 
 void ThreadSlotManager::releaseSlot_(ThreadSlot* slot) noexcept{
+    if(release_hook_) {
+        release_hook_(release_hook_context_, slot);
+    }
     free_slots_.push(slot);
 }
 
@@ -47,8 +79,17 @@ ThreadSlot* ThreadSlotManager::expandAndAcquire() {
         return slot;
     }
 
+    const size_t segment_index = segment_count_.load(std::memory_order_relaxed);
+    if (segment_index == kMaxSegments) {
+        return nullptr;
+    }
+
     const size_t current_capacity = capacity_.load(std::memory_order_relaxed);
-    const size_t new_slots_to_add = (current_capacity == 0) ? kInitialCapacity : current_capacity;
+    size_t new_slots_to_add = (current_capacity == 0) ? kInitialCapacity : current_capacity;
+    // 单个内存段不超过 ThreadHeap 的小对象上限，避免走整块 chunk 的大对象路径
+    if (new_slots_to_add > kMaxSlotsPerSegment) {
+        new_slots_to_add = kMaxSlotsPerSegment;
+    }
 
     void* raw_mem = ThreadHeap::allocate(sizeof(ThreadSlot) * new_slots_to_add);
     if(!raw_mem) {
@@ -62,21 +103,15 @@ ThreadSlot* ThreadSlotManager::expandAndAcquire() {
         new(&new_slots_array[i]) ThreadSlot();
     }
 
-    detail::ThreadHeapArrayDeleter<ThreadSlot> deleter{new_slots_to_add};
-    Segment new_segment(new_slots_array, deleter);
+    // 先发布段，再把槽位交给其他线程：任何被持有的槽位都一定能被 forEachSlot 看到
+    segments_[segment_index].count = new_slots_to_add;
+    segments_[segment_index].slots.store(new_slots_array, std::memory_order_relaxed);
+    segment_count_.store(segment_index + 1, std::memory_order_release);
+    capacity_.fetch_add(new_slots_to_add, std::memory_order_relaxed);
 
     for(size_t i = 0; i < new_slots_to_add - 1; ++i) {
         free_slots_.push(&new_slots_array[i]);
     }
 
-    segments_.push_back(std::move(new_segment));
-    capacity_.fetch_add(new_slots_to_add, std::memory_order_relaxed);
-
     return &new_slots_array[new_slots_to_add -1];
-}
-
-ThreadSlotManager::LocalSlotProxy::~LocalSlotProxy() {
-    if(manager_ && slot_) {
-        manager_->releaseSlot_(slot_);
-    }
 }
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include "Tool/AsymmetricFence.hpp"
+
+#include <linux/membarrier.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static long membarrier_call(int cmd) noexcept {
+    return ::syscall(SYS_membarrier, cmd, 0, 0);
+}
+
+// 注册状态属于地址空间，fork 出的子进程需要重新注册
+static void reregister_in_child() noexcept {
+    membarrier_call(MEMBARRIER_CMD_REGISTER_GLOBAL_EXPEDITED);
+}
+
+bool AsymmetricFence::registerExpedited_() noexcept {
+    const long supported = membarrier_call(MEMBARRIER_CMD_QUERY);
+    if (supported < 0 || (supported & MEMBARRIER_CMD_GLOBAL_EXPEDITED) == 0) {
+        return false;
+    }
+    if (membarrier_call(MEMBARRIER_CMD_REGISTER_GLOBAL_EXPEDITED) != 0) {
+        return false;
+    }
+    pthread_atfork(nullptr, nullptr, &reregister_in_child);
+    return true;
+}
+
+void AsymmetricFence::heavy() noexcept {
+    // 本线程自己的 StoreLoad 顺序仍由普通屏障保证
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (isExpedited()) {
+        membarrier_call(MEMBARRIER_CMD_GLOBAL_EXPEDITED);
+    }
+}
@@ -0,0 +1,39 @@
+#include "Tool/InstanceRegistry.hpp"
+
+#include <pthread.h>
+#include <unordered_set>
+
+static std::unordered_set<std::uint64_t>& live_instances() {
+    static std::unordered_set<std::uint64_t>* ids = new std::unordered_set<std::uint64_t>();
+    return *ids;
+}
+
+std::uint64_t InstanceRegistry::registerInstance() {
+    static std::once_flag fork_handler_once;
+    std::call_once(fork_handler_once, []() { pthread_atfork(nullptr, nullptr, &onForkChild_); });
+
+    static std::atomic<std::uint64_t> next_id{1};
+    const std::uint64_t id = next_id.fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(getMutex());
+    live_instances().insert(id);
+    return id;
+}
+
+void InstanceRegistry::unregisterInstance(std::uint64_t id) {
+    std::lock_guard<std::mutex> lock(getMutex());
+    live_instances().erase(id);
+}
+
+std::mutex& InstanceRegistry::getMutex() noexcept {
+    static std::mutex* mtx = new std::mutex();
+    return *mtx;
+}
+
+bool InstanceRegistry::isLive(std::uint64_t id) {
+    return live_instances().count(id) != 0;
+}
+
+void InstanceRegistry::onForkChild_() noexcept {
+    fork_generation_.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,91 @@
+#include "Tool/ShmEventCount.hpp"
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <climits>
+#include <ctime>
+
+// 注意：不使用 FUTEX_PRIVATE_FLAG，等待者与唤醒者可能位于不同进程
+static long futex_call(std::atomic<std::uint32_t>* addr, int op, std::uint32_t val,
+                       const struct timespec* timeout) {
+    return ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(addr), op, val, timeout,
+                     nullptr, 0);
+}
+
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t),
+              "futex word must be a plain 32-bit integer");
+
+ShmEventCount::ShmEventCount() noexcept {
+    epoch_.store(0, std::memory_order_relaxed);
+    waiters_.store(0, std::memory_order_release);
+}
+
+ShmEventCount::Key ShmEventCount::prepareWait() noexcept {
+    // seq_cst 的 RMW 与 notify 中的 seq_cst 屏障配对：
+    // 要么生产者看到我们的登记，要么我们随后的复查看到它发布的数据。
+    waiters_.fetch_add(1, std::memory_order_seq_cst);
+    return epoch_.load(std::memory_order_acquire);
+}
+
+void ShmEventCount::cancelWait() noexcept {
+    waiters_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool ShmEventCount::wait(Key key, std::chrono::nanoseconds timeout) noexcept {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    bool notified = false;
+
+    for (;;) {
+        if (epoch_.load(std::memory_order_acquire) != key) {
+            notified = true;
+            break;
+        }
+
+        auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::nanoseconds::zero()) {
+            break;
+        }
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count();
+        struct timespec ts;
+        ts.tv_sec  = static_cast<time_t>(ns / 1000000000LL);
+        ts.tv_nsec = static_cast<long>(ns % 1000000000LL);
+
+        // epoch_ 仍等于 key 时才会真正挂起；EAGAIN / EINTR / 超时都回到循环顶部复查
+        futex_call(&epoch_, FUTEX_WAIT, key, &ts);
+    }
+
+    cancelWait();
+    return notified;
+}
+
+void ShmEventCount::notifyOne() noexcept {
+    wake_(1);
+}
+
+void ShmEventCount::notifyAll() noexcept {
+    wake_(INT_MAX);
+}
+
+std::uint32_t ShmEventCount::getWaiterCount() const noexcept {
+    return waiters_.load(std::memory_order_relaxed);
+}
+
+void ShmEventCount::wake_(int count) noexcept {
+    // 与 prepareWait 的 seq_cst RMW 配对，保证数据发布先于读取等待者数量
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_relaxed) == 0) {
+        return; // 快速路径：没有等待者，不进入内核
+    }
+    epoch_.fetch_add(1, std::memory_order_release);
+    futex_call(&epoch_, FUTEX_WAKE, static_cast<std::uint32_t>(count), nullptr);
+}
+
+void ShmEventCount::cpuRelax_() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    asm volatile("pause" ::: "memory");
+#else
+    asm volatile("" ::: "memory");
+#endif
+}
@@ -22,6 +22,21 @@ void ManagedList::appendUsed(BlockHeader* blk) noexcept {
     tail_ = blk;
 }
 
+void ManagedList::appendList(ManagedList& other) noexcept {
+    if (!other.head_) return;
+
+    if (!head_) {
+        head_ = other.head_;
+    } else {
+        tail_->next = other.head_;
+    }
+    tail_ = other.tail_;
+
+    other.head_ = other.tail_ = nullptr;
+    other.cursor_prev_ = other.cursor_cur_ = nullptr;
+    cursor_prev_ = cursor_cur_ = nullptr;
+}
+
 BlockHeader* ManagedList::reclaimNextFree() noexcept {
     // 如果游标未设置，认为没有开启遍历
     if (!cursor_cur_) return nullptr;
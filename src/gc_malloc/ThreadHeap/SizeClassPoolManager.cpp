@@ -103,6 +103,14 @@ bool SizeClassPoolManager::releaseBlock(void* ptr) noexcept {
     return true;
 }
 
+void SizeClassPoolManager::releaseEmptyPools() noexcept {
+    if (!return_cb_) return;
+
+    while (MemSubPool* p = empty_.popFront()) {
+        return_cb_(return_ctx_, p);
+    }
+}
+
 // ===================== 统计 / 查询 =====================
 
 std::size_t SizeClassPoolManager::getBlockSize() const noexcept {
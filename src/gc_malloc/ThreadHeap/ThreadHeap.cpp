@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <limits>
 #include <cassert>
+#include <mutex>
+#include <unistd.h>
 
 #include "gc_malloc/CentralHeap/CentralHeap.hpp"
 #include "gc_malloc/ThreadHeap/MemSubPool.hpp"
@@ -10,6 +12,33 @@
 #include "gc_malloc/ThreadHeap/ProcessAllocatorContext.hpp"
 
 
+namespace {
+
+// 已退出线程遗留的在用块（进程本地）。fork 出的子进程继承的是父进程的链表副本，
+// 其中的块归父进程回收，子进程第一次使用时丢弃副本
+struct OrphanBlocks {
+    std::mutex  lock;
+    ManagedList blocks;
+    pid_t       owner_pid = ::getpid();
+};
+
+OrphanBlocks& orphanBlocks() noexcept {
+    // 与进程同寿命：线程本地 ThreadHeap 的析构可能晚于静态对象
+    static OrphanBlocks* orphans = new OrphanBlocks();
+    return *orphans;
+}
+
+void dropInheritedOrphans(OrphanBlocks& orphans) noexcept {
+    const pid_t self = ::getpid();
+    if (orphans.owner_pid != self) {
+        ManagedList inherited;
+        inherited.appendList(orphans.blocks);
+        orphans.owner_pid = self;
+    }
+}
+
+} // namespace
+
 // -------------------- 对外公共接口 --------------------
 
 void* ThreadHeap::allocate(std::size_t nbytes) noexcept {
@@ -45,7 +74,8 @@ void ThreadHeap::deallocate(void* ptr) noexcept {
 }
 
 std::size_t ThreadHeap::garbageCollect(std::size_t max_scan) noexcept {
-    return local().reclaimBatch(max_scan);
+    const std::size_t reclaimed = local().reclaimBatch(max_scan);
+    return reclaimed + reclaimOrphans_(max_scan);
 }
 
 // -------------------- 内部实现（TLS / 构造 / 回调桥） --------------------
@@ -70,6 +100,15 @@ ThreadHeap::ThreadHeap() noexcept
 }
 
 ThreadHeap::~ThreadHeap() {
+    // 线程退出：先回收已被释放的块，再把变空的子池交还 CentralHeap，
+    // 否则每个退出的线程都会在每个用过的 size-class 上永久占住若干个 2MB chunk。
+    // 仍有在用块的子池随孤儿链表交给之后的 garbageCollect（其他线程之后的释放只会标记块头）。
+    reclaimBatch(SIZE_MAX);
+    for (std::size_t i = 0; i < k_class_count; ++i) {
+        at(managers_storage_[i]).releaseEmptyPools();
+    }
+    orphanUsedBlocks_();
+
     for (std::size_t i = 0; i < k_class_count; ++i) {
         at(managers_storage_[i]).~SizeClassPoolManager();
     }
@@ -96,8 +135,8 @@ MemSubPool* ThreadHeap::refillFromCentral_cb(void* ctx) noexcept {
 void ThreadHeap::returnToCentral_cb(void* /*ctx*/, MemSubPool* p) noexcept {
     if (!p) return;
     p->~MemSubPool();
-    ThreadHeap& th = local();
-    th.CentralHeap_ref_.releaseChunk(static_cast<void*>(p), SizeClassConfig::kChunkSizeBytes);
+    // 线程退出时也会经由这里交还子池：不再访问正在析构的线程本地实例
+    ProcessAllocatorContext::getCentralHeap()->releaseChunk(static_cast<void*>(p), SizeClassConfig::kChunkSizeBytes);
 }
 
 // -------------------- 小工具 --------------------
@@ -107,6 +146,41 @@ void ThreadHeap::attachUsed(BlockHeader* blk) noexcept {
     managed_list_.appendUsed(blk);
 }
 
+void ThreadHeap::orphanUsedBlocks_() noexcept {
+    if (managed_list_.empty()) return;
+
+    OrphanBlocks& orphans = orphanBlocks();
+    std::lock_guard<std::mutex> guard(orphans.lock);
+    dropInheritedOrphans(orphans);
+    orphans.blocks.appendList(managed_list_);
+}
+
+std::size_t ThreadHeap::reclaimOrphans_(std::size_t max_scan) noexcept {
+    OrphanBlocks& orphans = orphanBlocks();
+    std::unique_lock<std::mutex> guard(orphans.lock, std::try_to_lock);
+    if (!guard.owns_lock()) return 0; // 另一个线程正在回收
+    dropInheritedOrphans(orphans);
+
+    std::size_t reclaimed = 0;
+    orphans.blocks.resetCursor();
+    while (reclaimed < max_scan) {
+        BlockHeader* freed = orphans.blocks.reclaimNextFree();
+        if (!freed) break;
+
+        // 孤儿子池不在任何 SizeClassPoolManager 的链表上，直接按 2MB 对齐找到所属子池
+        const auto mask = static_cast<std::uintptr_t>(MemSubPool::kPoolTotalSize) - 1;
+        auto* pool = reinterpret_cast<MemSubPool*>(reinterpret_cast<std::uintptr_t>(freed) & ~mask);
+        pool->release(freed);
+        ++reclaimed;
+
+        // 子池的块都在孤儿链表上，变空后不会再有人引用它
+        if (pool->isEmpty()) {
+            returnToCentral_cb(nullptr, pool);
+        }
+    }
+    return reclaimed;
+}
+
 std::size_t ThreadHeap::reclaimBatch(std::size_t max_scan) noexcept {
     std::size_t reclaimed = 0;
     std::size_t scanned   = 0;
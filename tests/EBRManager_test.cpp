@@ -6,6 +6,8 @@
 
 #include "fixtures/ThreadHeapTestFixture.hpp" // 您的内存分配器夹具
 #include "EBRManager/EBRManager.hpp"         // 被测试的类
+#include "EBRManager/EBRReclaimer.hpp"
+#include "EBRManager/guard.hpp"
 
 // ============================================================================
 // --- 测试辅助工具 ---
@@ -27,15 +29,33 @@ struct TrackableObject {
     }
 };
 
+// 自带 EBRHook 的对象：走侵入式退休路径
+struct HookedTrackableObject : public EBRHook {
+    std::atomic<size_t>* destruction_counter;
+
+    HookedTrackableObject(std::atomic<size_t>* counter) : destruction_counter(counter) {}
+
+    ~HookedTrackableObject() {
+        destruction_counter->fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
 
 // ============================================================================
 // --- 测试夹具 (Fixture) ---
 // ============================================================================
 
+// 开放 getLocalSlot_：槽位耗尽时它返回 nullptr，enter/leave 静默地不提供任何保护，
+// 依赖读者受保护的测试要先确认读者确实拿到了槽位。
+class SlotProbeEBRManager : public EBRManager {
+public:
+    using EBRManager::getLocalSlot_;
+};
+
 class EBRManagerTest : public ThreadHeapTestFixture {
 protected:
     // 每个测试用例都会有一个全新的 EBRManager 实例。
-    EBRManager ebr_manager_;
+    SlotProbeEBRManager ebr_manager_;
 };
 
 
@@ -373,4 +393,412 @@ TEST_F(EBRManagerTest, MultiThreadRetireComplexObjects) {
 
     // 验证所有对象都被正确销毁（析构函数中的断言没有失败）
     EXPECT_EQ(destruction_counter.load(), kTotalObjects);
-}
\ No newline at end of file
+}
+
+/**
+ * @test IndependentManagersPerThread
+ * @brief 同一线程使用两个 EBRManager 时，各自拥有独立的槽位与 limbo bag。
+ *
+ * 线程在管理器 A 的临界区内阻塞，不应影响管理器 B 的纪元推进与回收。
+ */
+TEST_F(EBRManagerTest, IndependentManagersPerThread) {
+    std::atomic<size_t> counter = 0;
+    EBRManager other_manager;
+
+    ebr_manager_.enter(); // 在 A 中保持活跃
+
+    other_manager.enter();
+    void* mem = ThreadHeap::allocate(sizeof(TrackableObject));
+    other_manager.retire(new(mem) TrackableObject(&counter));
+    other_manager.leave();
+
+    for (size_t i = 0; i < EBRManager::kNumEpochLists; ++i) {
+        other_manager.enter();
+        other_manager.leave();
+    }
+    EXPECT_EQ(counter.load(), 1u);
+
+    ebr_manager_.leave();
+}
+
+/**
+ * @test HookedRetire_ReclaimedAfterGracePeriod
+ * @brief 继承 EBRHook 的对象走侵入式链，回收时机与普通对象一致。
+ *
+ * 另一个线程停在临界区内时纪元无法推进，退休的对象超过一个 bag 的容量，
+ * 钩子链会整体转交全局链表；读者离开后所有对象都应被析构且只析构一次。
+ */
+TEST_F(EBRManagerTest, HookedRetire_ReclaimedAfterGracePeriod) {
+    std::atomic<size_t> counter = 0;
+    constexpr size_t kObjects = RetireBag::kCapacity * 3 + 7;
+
+    std::atomic<bool> reader_entered{false};
+    std::atomic<bool> release_reader{false};
+    std::thread reader([&]() {
+        ebr_manager_.enter();
+        reader_entered.store(true, std::memory_order_release);
+        while (!release_reader.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        ebr_manager_.leave();
+    });
+    while (!reader_entered.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+
+    for (size_t i = 0; i < kObjects; ++i) {
+        ebr_manager_.enter();
+        void* mem = ThreadHeap::allocate(sizeof(HookedTrackableObject));
+        ebr_manager_.retire(new(mem) HookedTrackableObject(&counter));
+        ebr_manager_.leave();
+    }
+    EXPECT_EQ(counter.load(), 0u);
+
+    release_reader.store(true, std::memory_order_release);
+    reader.join();
+
+    for (size_t i = 0; i < EBRManager::kNumEpochLists + 1; ++i) {
+        ebr_manager_.enter();
+        ebr_manager_.leave();
+    }
+    EXPECT_EQ(counter.load(), kObjects);
+}
+
+/**
+ * @test BackgroundMode_LeaveDoesNotReclaim
+ * @brief 后台模式下 leave 不做任何回收，垃圾只由 reclaimStep 分批释放。
+ */
+TEST_F(EBRManagerTest, BackgroundMode_LeaveDoesNotReclaim) {
+    std::atomic<size_t> counter = 0;
+    constexpr size_t kObjects = 300;
+
+    ebr_manager_.setBackgroundReclaim(true);
+
+    // 在独立线程中退休，线程退出时剩余的 bag 也会转交全局链表
+    std::thread worker([&]() {
+        for (size_t i = 0; i < kObjects; ++i) {
+            ebr_manager_.enter();
+            void* mem = ThreadHeap::allocate(sizeof(TrackableObject));
+            ebr_manager_.retire(new(mem) TrackableObject(&counter));
+            ebr_manager_.leave();
+        }
+    });
+    worker.join();
+    EXPECT_EQ(counter.load(), 0u);
+
+    // 每一步至多释放 batch 个节点
+    constexpr size_t kBatch = 16;
+    for (size_t step = 0; step < kObjects && counter.load() < kObjects; ++step) {
+        const size_t before = counter.load();
+        const size_t reclaimed = ebr_manager_.reclaimStep(kBatch);
+        EXPECT_LE(reclaimed, kBatch);
+        EXPECT_EQ(counter.load() - before, reclaimed);
+    }
+    EXPECT_EQ(counter.load(), kObjects);
+
+    ebr_manager_.setBackgroundReclaim(false);
+}
+
+/**
+ * @test BackgroundReclaimer_MultiThread
+ * @brief 回收线程池与多个业务线程并发运行，所有对象最终都被释放且只释放一次。
+ */
+TEST_F(EBRManagerTest, BackgroundReclaimer_MultiThread) {
+    std::atomic<size_t> counter = 0;
+    // 与整个 EBRManagerTest 共用一块分配器区域：每个业务线程都要为用到的 size class 占用 chunk
+    constexpr int kThreads = 2;
+    constexpr size_t kPerThread = 2000;
+
+    EBRReclaimer reclaimer(ebr_manager_, 2, 64, std::chrono::microseconds(50));
+    EXPECT_TRUE(ebr_manager_.isBackgroundReclaim());
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < kThreads; ++t) {
+        workers.emplace_back([&]() {
+            for (size_t i = 0; i < kPerThread; ++i) {
+                ebr_manager_.enter();
+                void* mem = ThreadHeap::allocate(sizeof(TrackableObject));
+                ebr_manager_.retire(new(mem) TrackableObject(&counter));
+                ebr_manager_.leave();
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    constexpr size_t kTotal = kThreads * kPerThread;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (counter.load() < kTotal && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(counter.load(), kTotal);
+    EXPECT_EQ(reclaimer.getReclaimedCount(), kTotal);
+
+    reclaimer.stop();
+    EXPECT_FALSE(ebr_manager_.isBackgroundReclaim());
+}
+
+/**
+ * @test NestedGuards_InnerLeaveKeepsProtection
+ * @brief 嵌套的 Guard：内层离开后外层仍受保护，只有最外层离开才允许回收。
+ */
+TEST_F(EBRManagerTest, NestedGuards_InnerLeaveKeepsProtection) {
+    std::atomic<size_t> counter = 0;
+    std::atomic<int> phase{0};
+    std::atomic<bool> reader_protected{false};
+
+    std::thread reader([&]() {
+        ebr::Guard outer(ebr_manager_);
+        for (int i = 0; i < 10; ++i) {
+            ebr::Guard inner(ebr_manager_); // 例如在外层区域内调用容器的 find
+        }
+        ThreadSlot* slot = ebr_manager_.getLocalSlot_();
+        reader_protected.store(slot != nullptr && slot->getNestDepth() == 1, std::memory_order_relaxed);
+        phase.store(1, std::memory_order_release);
+        while (phase.load(std::memory_order_acquire) != 2) {
+            std::this_thread::yield();
+        }
+    });
+    while (phase.load(std::memory_order_acquire) != 1) {
+        std::this_thread::yield();
+    }
+    if (!reader_protected.load(std::memory_order_relaxed)) {
+        phase.store(2, std::memory_order_release);
+        reader.join();
+    }
+    ASSERT_TRUE(reader_protected.load(std::memory_order_relaxed)) << "读者没有拿到槽位，或内层离开破坏了外层保护";
+
+    ebr_manager_.enter();
+    void* mem = ThreadHeap::allocate(sizeof(TrackableObject));
+    ebr_manager_.retire(new(mem) TrackableObject(&counter));
+    ebr_manager_.leave();
+    for (int i = 0; i < 100; ++i) {
+        ebr_manager_.enter();
+        ebr_manager_.leave();
+    }
+    EXPECT_EQ(counter.load(), 0u); // 读者的外层 Guard 仍在
+
+    phase.store(2, std::memory_order_release);
+    reader.join();
+
+    for (size_t i = 0; i < EBRManager::kNumEpochLists; ++i) {
+        ebr_manager_.enter();
+        ebr_manager_.leave();
+    }
+    EXPECT_EQ(counter.load(), 1u);
+}
+
+/**
+ * @test StalledReader_StatsReportBlockingSlot
+ * @brief 读者停在临界区内时，getStats 能给出挡住纪元的槽位、停滞时长与待回收数量。
+ */
+TEST_F(EBRManagerTest, StalledReader_StatsReportBlockingSlot) {
+    std::atomic<size_t> counter = 0;
+    constexpr size_t kObjects = 200;
+
+    std::atomic<bool> reader_entered{false};
+    std::atomic<bool> reader_has_slot{false};
+    std::atomic<bool> release_reader{false};
+    std::thread reader([&]() {
+        ebr_manager_.enter();
+        reader_has_slot.store(ebr_manager_.getLocalSlot_() != nullptr, std::memory_order_relaxed);
+        reader_entered.store(true, std::memory_order_release);
+        while (!release_reader.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        ebr_manager_.leave();
+    });
+    while (!reader_entered.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+    if (!reader_has_slot.load(std::memory_order_relaxed)) {
+        release_reader.store(true, std::memory_order_release);
+        reader.join();
+    }
+    ASSERT_TRUE(reader_has_slot.load(std::memory_order_relaxed)) << "读者没有拿到槽位，不会挡住纪元";
+
+    for (size_t i = 0; i < kObjects; ++i) {
+        ebr_manager_.enter();
+        void* mem = ThreadHeap::allocate(sizeof(TrackableObject));
+        ebr_manager_.retire(new(mem) TrackableObject(&counter));
+        ebr_manager_.leave();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    EBRManager::Stats stats = ebr_manager_.getStats();
+    EXPECT_GE(stats.blocking_slot, 0);
+    EXPECT_LT(stats.blocking_slot_epoch, stats.global_epoch);
+    EXPECT_GE(stats.stalled_ns, 5u * 1000 * 1000);
+    EXPECT_EQ(stats.pending_garbage, kObjects);
+    EXPECT_EQ(counter.load(), 0u);
+
+    release_reader.store(true, std::memory_order_release);
+    reader.join();
+
+    for (size_t i = 0; i < EBRManager::kNumEpochLists + 1; ++i) {
+        ebr_manager_.enter();
+        ebr_manager_.leave();
+    }
+    stats = ebr_manager_.getStats();
+    EXPECT_EQ(counter.load(), kObjects);
+    EXPECT_EQ(stats.pending_garbage, 0u);
+    EXPECT_EQ(stats.blocking_slot, -1);
+}
+
+/**
+ * @test RobustMode_BoundsGarbageWithStalledReader
+ * @brief 健壮模式下，停滞读者只能保住它进入时已经存在的节点；
+ * 之后出生的钩子节点照常释放，待回收数量保持有界。
+ */
+TEST_F(EBRManagerTest, RobustMode_BoundsGarbageWithStalledReader) {
+    std::atomic<size_t> counter = 0;
+    constexpr size_t kObjects = 2000;
+    ebr_manager_.setRobustMode(true, std::chrono::nanoseconds(0));
+
+    std::atomic<bool> reader_entered{false};
+    std::atomic<bool> reader_has_slot{false};
+    std::atomic<bool> release_reader{false};
+    std::thread reader([&]() {
+        ebr_manager_.enter();
+        reader_has_slot.store(ebr_manager_.getLocalSlot_() != nullptr, std::memory_order_relaxed);
+        reader_entered.store(true, std::memory_order_release);
+        while (!release_reader.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        ebr_manager_.leave();
+    });
+    while (!reader_entered.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+    if (!reader_has_slot.load(std::memory_order_relaxed)) {
+        release_reader.store(true, std::memory_order_release);
+        reader.join();
+    }
+    ASSERT_TRUE(reader_has_slot.load(std::memory_order_relaxed)) << "读者没有拿到槽位，不会挡住纪元";
+
+    for (size_t i = 0; i < kObjects; ++i) {
+        ebr_manager_.enter();
+        void* mem = ThreadHeap::allocate(sizeof(HookedTrackableObject));
+        auto* obj = new(mem) HookedTrackableObject(&counter);
+        ebr::stampBirth(ebr_manager_, obj);
+        ebr_manager_.retire(obj);
+        ebr_manager_.leave();
+    }
+
+    EBRManager::Stats stats = ebr_manager_.getStats();
+    EXPECT_GT(stats.robust_reclaimed, 0u);
+    EXPECT_EQ(counter.load(), stats.robust_reclaimed);
+    EXPECT_LT(stats.pending_garbage, kObjects / 4);
+
+    release_reader.store(true, std::memory_order_release);
+    reader.join();
+
+    for (size_t i = 0; i < EBRManager::kNumEpochLists + 1; ++i) {
+        ebr_manager_.enter();
+        ebr_manager_.leave();
+    }
+    EXPECT_EQ(counter.load(), kObjects);
+}
+
+/**
+ * @test GarbageCollector_HelpersShareLongList
+ * @brief 发布出去的长链由多个线程通过 help 分块并行释放，每个对象只释放一次。
+ */
+TEST_F(EBRManagerTest, GarbageCollector_HelpersShareLongList) {
+    std::atomic<size_t> counter = 0;
+    constexpr size_t kObjects = GarbageCollector::kChunkSize * 40 + 5;
+    constexpr int kHelpers = 4;
+
+    GarbageCollector collector;
+    GarbageNode* head = nullptr;
+    for (size_t i = 0; i < kObjects; ++i) {
+        void* mem = ThreadHeap::allocate(sizeof(TrackableObject));
+        auto* obj = new(mem) TrackableObject(&counter);
+        void* node_mem = ThreadHeap::allocate(sizeof(GarbageNode));
+        auto* g_node = new(node_mem) GarbageNode(obj, [](void* p) {
+            static_cast<TrackableObject*>(p)->~TrackableObject();
+            ThreadHeap::deallocate(p);
+        });
+        g_node->next = head;
+        head = g_node;
+    }
+    EXPECT_EQ(collector.defer(head), 0u);
+    EXPECT_TRUE(collector.hasPending());
+
+    std::atomic<size_t> reclaimed{0};
+    std::vector<std::thread> helpers;
+    for (int t = 0; t < kHelpers; ++t) {
+        helpers.emplace_back([&]() {
+            while (collector.hasPending()) {
+                const size_t freed = collector.help();
+                EXPECT_LE(freed, GarbageCollector::kChunkSize);
+                reclaimed.fetch_add(freed, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& t : helpers) t.join();
+    reclaimed.fetch_add(collector.drain(), std::memory_order_relaxed);
+
+    EXPECT_EQ(reclaimed.load(), kObjects);
+    EXPECT_EQ(counter.load(), kObjects);
+}
+
+/**
+ * @test RetireBudget_HelpReclaimAndOverrun
+ * @brief 后台模式下没有回收线程时，超出退休预算的 retire 代为执行 reclaimStep，
+ * 未释放的对象数保持在预算附近；停滞的读者挡住回收时，retire 不会无限等待，只记录超支次数。
+ */
+TEST_F(EBRManagerTest, RetireBudget_HelpReclaimAndOverrun) {
+    std::atomic<size_t> counter = 0;
+    constexpr size_t kObjects = 2000;
+    constexpr size_t kMaxNodes = 32;
+    ebr_manager_.setBackgroundReclaim(true);
+    ebr_manager_.setRetireBudget(kMaxNodes, 0);
+
+    for (size_t i = 0; i < kObjects; ++i) {
+        ebr_manager_.enter();
+        void* mem = ThreadHeap::allocate(sizeof(TrackableObject));
+        ebr_manager_.retire(new(mem) TrackableObject(&counter));
+        ebr_manager_.leave();
+    }
+    EBRManager::Stats stats = ebr_manager_.getStats();
+    EXPECT_GT(counter.load(), kObjects - 2 * kMaxNodes);
+    // 超出预算后每次 retire 推进一个纪元，只多出最近几个纪元里的对象
+    EXPECT_LE(stats.pending_garbage, kMaxNodes + EBRManager::kNumEpochLists + 1);
+    EXPECT_EQ(stats.retired_bytes, stats.pending_garbage * sizeof(TrackableObject));
+    ebr_manager_.setBackgroundReclaim(false);
+    const uint64_t overruns = ebr_manager_.getBudgetOverrunCount();
+
+    std::atomic<bool> reader_entered{false};
+    std::atomic<bool> release_reader{false};
+    std::thread reader([&]() {
+        ebr_manager_.enter();
+        reader_entered.store(true, std::memory_order_release);
+        while (!release_reader.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        ebr_manager_.leave();
+    });
+    while (!reader_entered.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+
+    const auto kBackpressure = std::chrono::microseconds(200);
+    ebr_manager_.setRetireBudget(kMaxNodes, 0, kBackpressure);
+    for (size_t i = 0; i < 4 * kMaxNodes; ++i) {
+        ebr_manager_.enter();
+        void* mem = ThreadHeap::allocate(sizeof(TrackableObject));
+        ebr_manager_.retire(new(mem) TrackableObject(&counter));
+        ebr_manager_.leave();
+    }
+    EXPECT_GE(ebr_manager_.getBudgetOverrunCount(), overruns + 3 * kMaxNodes);
+
+    release_reader.store(true, std::memory_order_release);
+    reader.join();
+
+    for (size_t i = 0; i < EBRManager::kNumEpochLists + 1; ++i) {
+        ebr_manager_.enter();
+        ebr_manager_.leave();
+    }
+    EXPECT_EQ(counter.load(), kObjects + 4 * kMaxNodes);
+    EXPECT_EQ(ebr_manager_.getRetiredBytes(), 0u);
+}
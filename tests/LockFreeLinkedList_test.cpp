@@ -11,6 +11,8 @@
 #include "fixtures/ThreadHeapTestFixture.hpp" // 假设您的测试环境有这个
 #include "LockFreeLinkedList/LockFreeLinkedList.hpp" // 引入待测试的链表
 #include "Hazard/HazardPointerOrganizer.hpp"     // 引入 HP 组织器
+#include "Hazard/HazardPtrHolder.hpp"
+#include "Hazard/HazardEraOrganizer.hpp"
 
 // ============================================================================
 // --- 类型别名 - 适配链表和 Organizer API ---
@@ -23,6 +25,10 @@ using List    = LockFreeLinkedList<value_t>;
 constexpr size_t kListHazardPointers = List::kHazardPointers;
 using ListHpOrganizer = HazardPointerOrganizer<node_t, kListHazardPointers>;
 
+// 危险纪元版本：接口相同，遍历时只发布纪元
+using ListHeOrganizer = HazardEraOrganizer<node_t, kListHazardPointers>;
+using HeList          = LockFreeLinkedList<value_t, DefaultHeapPolicy, ListHeOrganizer>;
+
 
 // ============================================================================
 // --- 测试夹具 (Fixture) ---
@@ -241,4 +247,221 @@ TEST_F(LockFreeLinkedListFixture, ConcurrentInsertRemove_DataRaces) {
     ThreadHeap::deallocate(list);
     hp_organizer->~ListHpOrganizer();
     ThreadHeap::deallocate(hp_organizer);
-}
\ No newline at end of file
+}
+
+// 8) 动态危险指针：holder 数量超过内联指针数时使用溢出块，扫描者同样能看到
+TEST_F(LockFreeLinkedListFixture, HazardPtrHolder_OverflowProtectsNodes) {
+    using Holder = HazardPtrHolder<ListHpOrganizer>;
+    const int kNodes = 40;   // 远多于 kListHazardPointers
+
+    auto* hp_organizer = new (ThreadHeap::allocate(sizeof(ListHpOrganizer))) ListHpOrganizer();
+
+    std::vector<std::atomic<node_t*>> sources(kNodes);
+    std::vector<Holder> holders;
+    holders.reserve(kNodes);
+    for (int i = 0; i < kNodes; ++i) {
+        sources[i].store(DefaultHeapPolicy::allocate<node_t>(i));
+        holders.emplace_back(*hp_organizer);
+        ASSERT_TRUE(holders.back().isValid());
+        EXPECT_EQ(holders.back().protect(sources[i]), sources[i].load());
+    }
+
+    // 全部节点退休后仍受保护，一个都不能释放
+    for (auto& src : sources) {
+        hp_organizer->retire(src.load());
+    }
+    EXPECT_EQ(hp_organizer->collect(), 0u);
+
+    // 释放一半 holder（包括溢出块中的），对应节点可以回收
+    holders.resize(kNodes / 2);
+    EXPECT_EQ(hp_organizer->collect(), (std::size_t)(kNodes / 2));
+
+    // 归还的下标可以再次领取；swap 只交换保护关系
+    Holder extra(*hp_organizer);
+    EXPECT_TRUE(extra.isValid());
+    extra.swap(holders.front());
+    holders.clear();
+    EXPECT_EQ(hp_organizer->collect(), (std::size_t)(kNodes / 2 - 1));
+    extra.reset();
+    EXPECT_EQ(hp_organizer->collect(), 1u);
+
+    hp_organizer->~ListHpOrganizer();
+    ThreadHeap::deallocate(hp_organizer);
+}
+
+// 8b) 溢出块分配失败：holder 无效而不是解引用空指针，之后的领取不受影响
+namespace {
+struct FailingOverflowPolicy {
+    static inline bool fail = false;
+
+    template <class T, class... Args>
+    static T* allocate(Args&&... args) {
+        return fail ? nullptr : DefaultHeapPolicy::allocate<T>(std::forward<Args>(args)...);
+    }
+
+    template <class T>
+    static void deallocate(T* p) noexcept {
+        DefaultHeapPolicy::deallocate(p);
+    }
+};
+} // namespace
+
+TEST_F(LockFreeLinkedListFixture, HazardPtrHolder_OverflowAllocationFailure) {
+    using Organizer = HazardPointerOrganizer<node_t, kListHazardPointers, FailingOverflowPolicy>;
+    using Holder    = HazardPtrHolder<Organizer>;
+
+    auto* organizer = new (ThreadHeap::allocate(sizeof(Organizer))) Organizer();
+    {
+        // 先占满内联指针（槽位块也在这里分配）
+        std::vector<Holder> holders;
+        holders.reserve(kListHazardPointers + 1);
+        for (std::size_t i = 0; i < kListHazardPointers; ++i) {
+            holders.emplace_back(*organizer);
+            ASSERT_TRUE(holders.back().isValid());
+        }
+
+        FailingOverflowPolicy::fail = true;
+        Holder failed(*organizer);
+        FailingOverflowPolicy::fail = false;
+        EXPECT_FALSE(failed.isValid());
+
+        std::atomic<node_t*> source{nullptr};
+        EXPECT_EQ(failed.protect(source), nullptr);   // 只读取不保护
+
+        holders.emplace_back(*organizer);
+        EXPECT_TRUE(holders.back().isValid());
+    }
+    organizer->~Organizer();
+    ThreadHeap::deallocate(organizer);
+}
+
+// 9) 危险纪元：发布的纪元只保护 [出生, 退休] 覆盖它的节点
+TEST_F(LockFreeLinkedListFixture, HazardEra_ProtectsByEraInterval) {
+    using Holder = HazardPtrHolder<ListHeOrganizer>;
+    auto* he_organizer = new (ThreadHeap::allocate(sizeof(ListHeOrganizer))) ListHeOrganizer();
+
+    node_t* old_node = DefaultHeapPolicy::allocate<node_t>(1);
+    he_organizer->stampBirth(old_node);
+    std::atomic<node_t*> source{old_node};
+
+    Holder holder(*he_organizer);
+    ASSERT_TRUE(holder.isValid());
+    EXPECT_EQ(holder.protect(source), old_node);
+    const std::uint64_t published = he_organizer->getEra();
+
+    source.store(nullptr);
+    he_organizer->retire(old_node);
+    EXPECT_EQ(he_organizer->collect(), 0u);   // 发布的纪元落在 old_node 的区间内
+    EXPECT_GT(he_organizer->getEra(), published);
+
+    // 在发布之后出生的节点不受这个纪元保护
+    node_t* young_node = DefaultHeapPolicy::allocate<node_t>(2);
+    he_organizer->stampBirth(young_node);
+    he_organizer->retire(young_node);
+    EXPECT_EQ(he_organizer->collect(), 1u);
+
+    holder.reset();
+    EXPECT_EQ(he_organizer->collect(), 1u);
+
+    he_organizer->~ListHeOrganizer();
+    ThreadHeap::deallocate(he_organizer);
+}
+
+// 10) 危险纪元下的并发读写：每个线程插入自己的一段值、删掉其中的偶数，读者持续遍历
+TEST_F(LockFreeLinkedListFixture, HazardEra_ConcurrentInsertRemoveWithReaders) {
+    auto* he_organizer = new (ThreadHeap::allocate(sizeof(ListHeOrganizer))) ListHeOrganizer();
+    auto* list         = new (ThreadHeap::allocate(sizeof(HeList))) HeList(*he_organizer);
+
+    constexpr int kWriters = 4;
+    constexpr int kReaders = 4;
+    constexpr int kValuesPerWriter = 200;
+    constexpr int kRounds = 5;
+    std::atomic<bool> start{false};
+    std::atomic<bool> done{false};
+    std::vector<std::thread> writers;
+    std::vector<std::thread> readers;
+
+    for (int t = 0; t < kWriters; ++t) {
+        writers.emplace_back([list, &start, t]() {
+            while (!start.load()) {}
+            const int base = t * kValuesPerWriter;
+            for (int round = 0; round < kRounds; ++round) {
+                for (int v = base; v < base + kValuesPerWriter; ++v) {
+                    list->insert(v);
+                }
+                for (int v = base; v < base + kValuesPerWriter; v += 2) {
+                    EXPECT_TRUE(list->remove(v));
+                }
+                if (round + 1 < kRounds) {
+                    for (int v = base + 1; v < base + kValuesPerWriter; v += 2) {
+                        EXPECT_TRUE(list->remove(v));
+                    }
+                }
+            }
+        });
+    }
+    for (int t = 0; t < kReaders; ++t) {
+        readers.emplace_back([list, &start, &done, t]() {
+            while (!start.load()) {}
+            int v = t;
+            while (!done.load(std::memory_order_relaxed)) {
+                list->contains(v);
+                v = (v + 37) % (kWriters * kValuesPerWriter);
+            }
+        });
+    }
+
+    start.store(true);
+    for (auto& w : writers) w.join();
+    done.store(true);
+    for (auto& r : readers) r.join();
+
+    for (int v = 0; v < kWriters * kValuesPerWriter; ++v) {
+        EXPECT_EQ(list->contains(v), v % 2 == 1) << "value " << v;
+    }
+
+    he_organizer->collect();
+    list->~HeList();
+    ThreadHeap::deallocate(list);
+    he_organizer->~ListHeOrganizer();
+    ThreadHeap::deallocate(he_organizer);
+}
+
+// 11) 危险纪元的退休预算：超出预算的 retire 代为回收另一个存活线程积压的节点
+TEST_F(LockFreeLinkedListFixture, HazardEra_BudgetHelpReclaimsOtherLiveThreads) {
+    constexpr std::size_t kOtherRetired = 40;   // 低于自动扫描阈值，对方自己不会回收
+    static_assert(kOtherRetired < ListHeOrganizer::kMinScanThreshold, "must stay below the scan threshold");
+
+    auto* he_organizer = new (ThreadHeap::allocate(sizeof(ListHeOrganizer))) ListHeOrganizer();
+    node_t* mine = DefaultHeapPolicy::allocate<node_t>(-1);
+    ASSERT_NE(mine, nullptr);
+    he_organizer->stampBirth(mine);
+
+    std::atomic<int> phase{0};
+    std::thread other([&]() {
+        for (std::size_t i = 0; i < kOtherRetired; ++i) {
+            node_t* node = DefaultHeapPolicy::allocate<node_t>(static_cast<int>(i));
+            he_organizer->stampBirth(node);
+            he_organizer->retire(node);
+        }
+        phase.store(1, std::memory_order_release);
+        while (phase.load(std::memory_order_acquire) != 2) {
+            std::this_thread::yield();
+        }
+    });
+    while (phase.load(std::memory_order_acquire) != 1) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(he_organizer->getRetiredNodes(), kOtherRetired);
+
+    he_organizer->setRetireBudget(kOtherRetired / 2, 0);
+    he_organizer->retire(mine);
+    EXPECT_EQ(he_organizer->getRetiredNodes(), 0u);
+    EXPECT_EQ(he_organizer->getBudgetOverrunCount(), 0u);
+
+    phase.store(2, std::memory_order_release);
+    other.join();
+
+    he_organizer->~ListHeOrganizer();
+    ThreadHeap::deallocate(he_organizer);
+}
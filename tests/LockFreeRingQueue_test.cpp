@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <numeric>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "fixtures/ShmTestFixture.hpp"
+#include "LockFreeRingQueue/LockFreeRingQueue.hpp"
+
+// ============================================================================
+// --- 类型别名 ---
+// ============================================================================
+using value_t = std::uint64_t;
+using SmallRing = LockFreeRingQueue<value_t, 8>;
+using Ring      = LockFreeRingQueue<value_t, 1024>;
+
+// ============================================================================
+// --- 测试夹具 (Fixture) ---
+// ============================================================================
+// 队列直接构造在共享内存里，验证其不依赖任何进程私有的指针。
+class LockFreeRingQueueFixture : public SharedMemoryTestFixture {
+protected:
+    template <class Q>
+    Q* createInShm() {
+        return new (segment->getHeapSection()) Q();
+    }
+};
+
+// ============================================================================
+// --- 测试用例 ---
+// ============================================================================
+
+// 1) 空队列
+TEST_F(LockFreeRingQueueFixture, EmptyQueue_TryPopFalse) {
+    auto* q = createInShm<SmallRing>();
+
+    value_t out = 0;
+    EXPECT_TRUE(q->isEmpty());
+    EXPECT_FALSE(q->tryPop(out));
+    EXPECT_EQ(q->tryPopBatch(&out, 1), 0u);
+
+    q->~SmallRing();
+}
+
+// 2) FIFO 顺序，跨越多圈
+TEST_F(LockFreeRingQueueFixture, PushThenPop_FIFOAcrossWrapAround) {
+    auto* q = createInShm<SmallRing>();
+
+    for (value_t round = 0; round < 5; ++round) {
+        for (value_t i = 0; i < 6; ++i) {
+            ASSERT_TRUE(q->tryPush(round * 100 + i));
+        }
+        EXPECT_EQ(q->approxSize(), 6u);
+        for (value_t i = 0; i < 6; ++i) {
+            value_t out = 0;
+            ASSERT_TRUE(q->tryPop(out));
+            EXPECT_EQ(out, round * 100 + i);
+        }
+    }
+    EXPECT_TRUE(q->isEmpty());
+
+    q->~SmallRing();
+}
+
+// 3) 满队列拒绝写入，腾出空间后恢复
+TEST_F(LockFreeRingQueueFixture, FullQueue_TryPushFalse) {
+    auto* q = createInShm<SmallRing>();
+
+    for (value_t i = 0; i < SmallRing::capacity(); ++i) {
+        ASSERT_TRUE(q->tryPush(i));
+    }
+    EXPECT_FALSE(q->tryPush(999));
+
+    value_t out = 0;
+    ASSERT_TRUE(q->tryPop(out));
+    EXPECT_EQ(out, 0u);
+    EXPECT_TRUE(q->tryPush(999));
+
+    q->~SmallRing();
+}
+
+// 4) 批量接口：部分成功时返回实际个数，且保持顺序
+TEST_F(LockFreeRingQueueFixture, BatchPushPop_PartialAndOrdered) {
+    auto* q = createInShm<SmallRing>();
+
+    value_t items[12];
+    std::iota(std::begin(items), std::end(items), 0);
+
+    EXPECT_EQ(q->tryPushBatch(items, 5), 5u);
+    // 只剩 3 个空位
+    EXPECT_EQ(q->tryPushBatch(items + 5, 7), 3u);
+    EXPECT_EQ(q->tryPushBatch(items + 8, 4), 0u);
+
+    value_t out[12] = {};
+    EXPECT_EQ(q->tryPopBatch(out, 4), 4u);
+    EXPECT_EQ(q->tryPopBatch(out + 4, 12), 4u);
+    for (value_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(out[i], i);
+    }
+    EXPECT_EQ(q->tryPopBatch(out, 12), 0u);
+
+    q->~SmallRing();
+}
+
+// 5) 多生产者多消费者：每个元素恰好被消费一次
+TEST_F(LockFreeRingQueueFixture, ConcurrentMPMC_NoLossNoDuplication) {
+    auto* q = createInShm<Ring>();
+
+    constexpr int kProducers = 4;
+    constexpr int kConsumers = 4;
+    constexpr value_t kPerProducer = 50000;
+    constexpr value_t kTotal = kProducers * kPerProducer;
+
+    std::vector<std::atomic<int>> seen(kTotal);
+    std::atomic<value_t> consumed{0};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kProducers; ++p) {
+        threads.emplace_back([q, p]() {
+            value_t base = static_cast<value_t>(p) * kPerProducer;
+            value_t i = 0;
+            while (i < kPerProducer) {
+                // 奇偶交替使用单个与批量接口
+                if (i % 2 == 0) {
+                    if (q->tryPush(base + i)) ++i;
+                } else {
+                    value_t batch[4];
+                    value_t n = std::min<value_t>(4, kPerProducer - i);
+                    for (value_t k = 0; k < n; ++k) batch[k] = base + i + k;
+                    i += q->tryPushBatch(batch, n);
+                }
+            }
+        });
+    }
+    for (int c = 0; c < kConsumers; ++c) {
+        threads.emplace_back([q, &seen, &consumed]() {
+            value_t batch[8];
+            while (consumed.load(std::memory_order_relaxed) < kTotal) {
+                std::size_t n = q->tryPopBatch(batch, 8);
+                for (std::size_t k = 0; k < n; ++k) {
+                    seen[batch[k]].fetch_add(1, std::memory_order_relaxed);
+                }
+                consumed.fetch_add(n, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    EXPECT_EQ(consumed.load(), kTotal);
+    for (value_t i = 0; i < kTotal; ++i) {
+        ASSERT_EQ(seen[i].load(), 1) << "value " << i;
+    }
+    EXPECT_TRUE(q->isEmpty());
+
+    q->~Ring();
+}
+
+// 6) 跨进程：子进程生产，父进程消费
+TEST_F(LockFreeRingQueueFixture, MultiProcess_ProducersInChildren) {
+    auto* q = createInShm<Ring>();
+
+    constexpr int kChildren = 4;
+    constexpr value_t kPerChild = 20000;
+
+    std::vector<pid_t> pids;
+    for (int c = 0; c < kChildren; ++c) {
+        pid_t pid = fork();
+        ASSERT_NE(pid, -1);
+        if (pid == 0) {
+            value_t base = static_cast<value_t>(c) * kPerChild;
+            for (value_t i = 0; i < kPerChild;) {
+                if (q->tryPush(base + i)) ++i;
+            }
+            _exit(0);
+        }
+        pids.push_back(pid);
+    }
+
+    std::vector<value_t> last(kChildren, 0);
+    std::vector<bool> started(kChildren, false);
+    value_t received = 0;
+    while (received < kChildren * kPerChild) {
+        value_t v = 0;
+        if (!q->tryPop(v)) continue;
+        int child = static_cast<int>(v / kPerChild);
+        ASSERT_LT(child, kChildren);
+        // 同一生产者的元素必须保持 FIFO
+        if (started[child]) {
+            ASSERT_GT(v, last[child]);
+        }
+        started[child] = true;
+        last[child] = v;
+        ++received;
+    }
+
+    for (pid_t pid : pids) {
+        int st = 0;
+        ASSERT_EQ(waitpid(pid, &st, 0), pid);
+        EXPECT_TRUE(WIFEXITED(st) && WEXITSTATUS(st) == 0);
+    }
+    EXPECT_TRUE(q->isEmpty());
+
+    q->~Ring();
+}
@@ -7,6 +7,7 @@
 #include <random>
 #include <algorithm>
 #include <numeric>
+#include <chrono>
 
 // 包含我们要测试的类的头文件
 #include "LockFreeSkipList/LockFreeSkipList.hpp"
@@ -323,4 +324,63 @@ TEST_F(LockFreeSkipListFixture, ConcurrentMixedWorkload) {
                 << "Skip list is not sorted after stress test!";
         }());
     });
-}
\ No newline at end of file
+}
+// 健壮模式：一个读者一直停在临界区内，其余线程各自插入、删除互不重叠的键；
+// 跳表必须保持正确，且删除的节点不必等停滞读者离开就能释放
+TEST_F(LockFreeSkipListFixture, RobustMode_StalledReaderDoesNotBlockReclaim) {
+    auto* ebr_manager = new (ThreadHeap::allocate(sizeof(EBRManager))) EBRManager();
+    ebr_manager->setRobustMode(true, std::chrono::nanoseconds(0));
+
+    std::atomic<bool> reader_entered{false};
+    std::atomic<bool> release_reader{false};
+    std::thread reader([&]() {
+        ebr::Guard guard(*ebr_manager);
+        reader_entered.store(true, std::memory_order_release);
+        while (!release_reader.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    });
+    while (!reader_entered.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+
+    std::thread worker([&]() {
+        auto* list = new (ThreadHeap::allocate(sizeof(SkipList))) SkipList(*ebr_manager);
+        const int kThreads = 4;
+        const int kKeysPerThread = 64;
+        const int kRounds = 50;
+        std::atomic<bool> ok{true};
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < kThreads; ++t) {
+            threads.emplace_back([&, t]() {
+                for (int round = 0; round < kRounds; ++round) {
+                    for (int k = 0; k < kKeysPerThread; ++k) {
+                        const int key = t * kKeysPerThread + k;
+                        if (!list->insert(key, std::to_string(key))) ok = false;
+                    }
+                    for (int k = 0; k < kKeysPerThread; ++k) {
+                        const int key = t * kKeysPerThread + k;
+                        ValueType value;
+                        if (!list->find(key, value) || value != std::to_string(key)) ok = false;
+                        if (!list->remove(key)) ok = false;
+                    }
+                }
+            });
+        }
+        for (auto& th : threads) th.join();
+        EXPECT_TRUE(ok.load());
+
+        list->~SkipList();
+        ThreadHeap::deallocate(list);
+    });
+    worker.join();
+
+    EXPECT_GT(ebr_manager->getStats().robust_reclaimed, 0u);
+
+    release_reader.store(true, std::memory_order_release);
+    reader.join();
+
+    ebr_manager->~EBRManager();
+    ThreadHeap::deallocate(ebr_manager);
+}
@@ -13,6 +13,8 @@
 #include "LockFreeStack/LockFreeStack.hpp"
 // *** 关键修改：现在只需要包含 Organizer，Stack 不再管理内存回收细节 ***
 #include "Hazard/HazardPointerOrganizer.hpp"
+#include "Hazard/HazardDomain.hpp"
+#include "LockFreeQueue/LockFreeQueue.hpp"
 
 // ============================================================================
 // --- 类型别名 - 适配新的 Organizer API ---
@@ -203,6 +205,8 @@ TEST_F(LockFreeStackFixture, ConcurrentPushPop_NoDataLossOrCorruption) {
     // 主线程再做最后一次兜底清理（处理可能的残留或全局列表）
     size_t final_sweep = hp_organizer->drainAllRetired();
     total_freed_count.fetch_add(final_sweep, std::memory_order_relaxed);
+    // 自动扫描释放的节点也要算进去
+    total_freed_count.fetch_add(hp_organizer->getAutoReclaimedCount(), std::memory_order_relaxed);
 
     // 现在我们断言：所有线程回收的总数 + 主线程回收的总数 == 总节点数
     EXPECT_EQ(total_freed_count.load(), (size_t)total_items);
@@ -212,4 +216,258 @@ TEST_F(LockFreeStackFixture, ConcurrentPushPop_NoDataLossOrCorruption) {
     ThreadHeap::deallocate(st);
     hp_organizer->~StackHpOrganizer();
     ThreadHeap::deallocate(hp_organizer);
-}
\ No newline at end of file
+}
+
+// 5) 自动扫描：从不调用 collect，退休节点也不会无限积压
+TEST_F(LockFreeStackFixture, AutoScan_BoundsRetiredBacklog) {
+    const int kItems = 10000;
+
+    auto* hp_organizer = new (ThreadHeap::allocate(sizeof(StackHpOrganizer))) StackHpOrganizer();
+    auto* st           = new (ThreadHeap::allocate(sizeof(Stack))) Stack(*hp_organizer);
+
+    int out = 0;
+    for (int i = 0; i < kItems; ++i) {
+        st->push(i);
+        ASSERT_TRUE(st->tryPop(out));
+        EXPECT_EQ(out, i);
+    }
+
+    // 每个槽位积压的节点数不超过扫描阈值
+    EXPECT_GT(hp_organizer->getAutoReclaimedCount(), 0u);
+    std::size_t remaining = hp_organizer->drainAllRetired();
+    EXPECT_LT(remaining, hp_organizer->getScanThreshold());
+    EXPECT_EQ(remaining + hp_organizer->getAutoReclaimedCount(), (std::size_t)kItems);
+
+    st->~Stack();
+    ThreadHeap::deallocate(st);
+    hp_organizer->~StackHpOrganizer();
+    ThreadHeap::deallocate(hp_organizer);
+}
+
+// 6) 槽位登记表：每个 Organizer 实例各有一个槽位，线程退出后槽位被复用
+TEST_F(LockFreeStackFixture, SlotRegistry_PerInstanceSlotsAreReused) {
+    auto* org_a = new (ThreadHeap::allocate(sizeof(StackHpOrganizer))) StackHpOrganizer();
+    auto* org_b = new (ThreadHeap::allocate(sizeof(StackHpOrganizer))) StackHpOrganizer();
+
+    // 同一线程在两个实例上拿到不同的槽位，且各自按缓存行对齐
+    auto* slot_a = org_a->acquireTlsSlot();
+    auto* slot_b = org_b->acquireTlsSlot();
+    ASSERT_NE(slot_a, nullptr);
+    ASSERT_NE(slot_b, nullptr);
+    EXPECT_NE(static_cast<void*>(slot_a), static_cast<void*>(slot_b));
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(slot_a) % 64, 0u);
+    EXPECT_EQ(org_a->acquireTlsSlot(), slot_a);
+
+    // 工作线程退出后归还槽位，下一个线程直接复用，槽位数不增长
+    StackHpOrganizer::SlotType* first = nullptr;
+    StackHpOrganizer::SlotType* second = nullptr;
+    std::thread([&] { first = org_a->acquireTlsSlot(); first->protect(0, nullptr); }).join();
+    std::thread([&] { second = org_a->acquireTlsSlot(); }).join();
+    EXPECT_NE(first, slot_a);
+    EXPECT_EQ(first, second);
+
+    std::vector<std::thread> workers;
+    std::atomic<int> ready{0};
+    std::atomic<bool> release{false};
+    const int kWorkers = 40;
+    for (int i = 0; i < kWorkers; ++i) {
+        workers.emplace_back([&] {
+            org_a->acquireTlsSlot();
+            ready.fetch_add(1);
+            while (!release.load()) std::this_thread::yield();
+        });
+    }
+    while (ready.load() < kWorkers) std::this_thread::yield();
+    // 扫描阈值随在用槽位数（主线程 + 工作线程）变化
+    EXPECT_EQ(org_a->getScanThreshold(),
+              StackHpOrganizer::kScanFactor * (kWorkers + 1) * kStackHazardPointers);
+    release.store(true);
+    for (auto& t : workers) t.join();
+    EXPECT_EQ(org_a->getScanThreshold(), StackHpOrganizer::kMinScanThreshold);
+
+    org_b->~StackHpOrganizer();
+    ThreadHeap::deallocate(org_b);
+    org_a->~StackHpOrganizer();
+    ThreadHeap::deallocate(org_a);
+}
+
+// 7) 线程本地回收：collect 只处理本线程与已退出线程的退休节点
+TEST_F(LockFreeStackFixture, Collect_OwnListAndOrphansOnly) {
+    const int kItems = 10;   // 低于自动扫描阈值
+
+    auto* hp_organizer = new (ThreadHeap::allocate(sizeof(StackHpOrganizer))) StackHpOrganizer();
+    auto* st           = new (ThreadHeap::allocate(sizeof(Stack))) Stack(*hp_organizer);
+
+    auto push_pop = [&] {
+        int out = 0;
+        for (int i = 0; i < kItems; ++i) {
+            st->push(i);
+            ASSERT_TRUE(st->tryPop(out));
+        }
+    };
+
+    // 存活线程的退休节点留给它自己回收
+    std::atomic<int> stage{0};
+    std::size_t worker_freed = 0;
+    std::thread worker([&] {
+        push_pop();
+        stage.store(1);
+        while (stage.load() != 2) std::this_thread::yield();
+        worker_freed = hp_organizer->collect();
+    });
+    while (stage.load() != 1) std::this_thread::yield();
+    EXPECT_EQ(hp_organizer->collect(), 0u);
+    stage.store(2);
+    worker.join();
+    EXPECT_EQ(worker_freed, (std::size_t)kItems);
+
+    // 已退出线程留下的退休节点由任意线程的 collect 接手
+    std::thread(push_pop).join();
+    EXPECT_EQ(hp_organizer->collect(), (std::size_t)kItems);
+    EXPECT_EQ(hp_organizer->drainAllRetired(), 0u);
+
+    st->~Stack();
+    ThreadHeap::deallocate(st);
+    hp_organizer->~StackHpOrganizer();
+    ThreadHeap::deallocate(hp_organizer);
+}
+
+// 8) 类型擦除的 HazardDomain：栈与队列共用一个域，每个线程只占一个槽位
+TEST_F(LockFreeStackFixture, HazardDomain_StackAndQueueShareOneDomain) {
+    using Domain      = HazardDomain<>;
+    using DomainStack = LockFreeStack<int, DefaultHeapPolicy, Domain>;
+    using DomainQueue = LockFreeQueue<long, DefaultHeapPolicy, Domain>;
+
+    const int kThreads = 4;
+    const int kItemsPerThread = 2000;
+
+    auto* domain = new (ThreadHeap::allocate(sizeof(Domain))) Domain();
+    auto* st     = new (ThreadHeap::allocate(sizeof(DomainStack))) DomainStack(*domain);
+    auto* q      = new (ThreadHeap::allocate(sizeof(DomainQueue))) DomainQueue(*domain);
+
+    std::atomic<int> ready{0};
+    std::atomic<bool> release{false};
+    std::atomic<long> sum{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < kItemsPerThread; ++i) {
+                st->push(i);
+                q->push(static_cast<long>(t) * kItemsPerThread + i);
+                int a = 0;
+                long b = 0;
+                if (st->tryPop(a)) sum.fetch_add(1);
+                if (q->tryPop(b)) sum.fetch_add(1);
+            }
+            ready.fetch_add(1);
+            while (!release.load()) std::this_thread::yield();
+        });
+    }
+    while (ready.load() < kThreads) std::this_thread::yield();
+    // 两种容器共用槽位：在用槽位数就是线程数
+    EXPECT_EQ(domain->getScanThreshold(),
+              std::max<std::size_t>(Domain::kMinScanThreshold,
+                                    Domain::kScanFactor * kThreads * Domain::kMaxPointers));
+    release.store(true);
+    for (auto& th : threads) th.join();
+
+    int a = 0;
+    long b = 0;
+    while (st->tryPop(a)) sum.fetch_add(1);
+    while (q->tryPop(b)) sum.fetch_add(1);
+    EXPECT_EQ(sum.load(), 2L * kThreads * kItemsPerThread);
+
+    // 一个域回收两种节点：每次出栈退休一个栈节点，每次出队退休一个旧哨兵
+    std::size_t freed = domain->drainAllRetired() + domain->getAutoReclaimedCount();
+    EXPECT_EQ(freed, 2u * kThreads * kItemsPerThread);
+
+    q->~DomainQueue();
+    ThreadHeap::deallocate(q);
+    st->~DomainStack();
+    ThreadHeap::deallocate(st);
+    domain->~Domain();
+    ThreadHeap::deallocate(domain);
+}
+
+// 9) 退休内存预算：超出预算的 retire 同步回收；被保护的节点挡住回收时计为超支，并按期限背压
+TEST_F(LockFreeStackFixture, RetireBudget_HelpReclaimAndBackpressure) {
+    const int kItems = 1000;
+    const std::size_t kMaxNodes = 16;
+
+    auto* hp_organizer = new (ThreadHeap::allocate(sizeof(StackHpOrganizer))) StackHpOrganizer();
+    auto* st           = new (ThreadHeap::allocate(sizeof(Stack))) Stack(*hp_organizer);
+    hp_organizer->setRetireBudget(kMaxNodes, 0);
+
+    // 没有读者时，每次超出预算都能就地回收干净
+    int out = 0;
+    for (int i = 0; i < kItems; ++i) {
+        st->push(i);
+        ASSERT_TRUE(st->tryPop(out));
+        EXPECT_LE(hp_organizer->getRetiredNodes(), kMaxNodes);
+    }
+    EXPECT_EQ(hp_organizer->getRetiredBytes(), hp_organizer->getRetiredNodes() * sizeof(node_t));
+    EXPECT_EQ(hp_organizer->getBudgetOverrunCount(), 0u);
+    hp_organizer->collect();
+    EXPECT_EQ(hp_organizer->getRetiredNodes(), 0u);
+
+    // 一个被危险指针保护的节点就超出字节预算：每次 retire 都先等待背压期限，再记一次超支
+    const auto kBackpressure = std::chrono::milliseconds(2);
+    hp_organizer->setRetireBudget(0, sizeof(node_t) / 2, kBackpressure);
+    auto* slot = hp_organizer->acquireTlsSlot();
+    node_t* pinned = DefaultHeapPolicy::allocate<node_t>(-1);
+    slot->protect(0, pinned);
+
+    const auto start = std::chrono::steady_clock::now();
+    hp_organizer->retire(pinned);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, kBackpressure);
+    EXPECT_EQ(hp_organizer->getBudgetOverrunCount(), 1u);
+    EXPECT_EQ(hp_organizer->getRetiredNodes(), 1u);
+    EXPECT_EQ(hp_organizer->getRetiredBytes(), sizeof(node_t));
+
+    slot->clear(0);
+    EXPECT_EQ(hp_organizer->collect(), 1u);
+    EXPECT_EQ(hp_organizer->getRetiredNodes(), 0u);
+    EXPECT_EQ(hp_organizer->getRetiredBytes(), 0u);
+
+    st->~Stack();
+    ThreadHeap::deallocate(st);
+    hp_organizer->~StackHpOrganizer();
+    ThreadHeap::deallocate(hp_organizer);
+}
+
+// 10) 预算按实例计量：另一个存活线程的退休链表低于扫描阈值时，超出预算的 retire 同样代为回收
+TEST_F(LockFreeStackFixture, RetireBudget_HelpReclaimsOtherLiveThreads) {
+    constexpr std::size_t kOtherRetired = 40;   // 低于自动扫描阈值，对方自己不会回收
+    static_assert(kOtherRetired < StackHpOrganizer::kMinScanThreshold, "must stay below the scan threshold");
+
+    auto* hp_organizer = new (ThreadHeap::allocate(sizeof(StackHpOrganizer))) StackHpOrganizer();
+    node_t* mine = DefaultHeapPolicy::allocate<node_t>(-1);
+    ASSERT_NE(mine, nullptr);
+
+    std::atomic<int> phase{0};
+    std::thread other([&]() {
+        for (std::size_t i = 0; i < kOtherRetired; ++i) {
+            hp_organizer->retire(DefaultHeapPolicy::allocate<node_t>(static_cast<int>(i)));
+        }
+        phase.store(1, std::memory_order_release);
+        while (phase.load(std::memory_order_acquire) != 2) {
+            std::this_thread::yield();
+        }
+    });
+    while (phase.load(std::memory_order_acquire) != 1) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(hp_organizer->getRetiredNodes(), kOtherRetired);
+
+    // 两个线程都还活着：本线程的一次 retire 就把对方的链表一起回收干净，不记超支
+    hp_organizer->setRetireBudget(kOtherRetired / 2, 0);
+    hp_organizer->retire(mine);
+    EXPECT_EQ(hp_organizer->getRetiredNodes(), 0u);
+    EXPECT_EQ(hp_organizer->getBudgetOverrunCount(), 0u);
+
+    phase.store(2, std::memory_order_release);
+    other.join();
+
+    hp_organizer->~StackHpOrganizer();
+    ThreadHeap::deallocate(hp_organizer);
+}
@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <string>
+
+#include "fixtures/ThreadHeapTestFixture.hpp"
+#include "EBRManager/QSBRManager.hpp"
+#include "EBRManager/guard.hpp"
+#include "LockFreeSkipList/LockFreeSkipList.hpp"
+#include "LockFreeHashMap/LockFreeHashMap.hpp"
+
+// ============================================================================
+// --- 测试辅助工具 ---
+// ============================================================================
+struct QsbrTrackedObject {
+    std::atomic<size_t>* destruction_counter;
+
+    explicit QsbrTrackedObject(std::atomic<size_t>* counter) : destruction_counter(counter) {}
+
+    ~QsbrTrackedObject() {
+        destruction_counter->fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+using QsbrSkipList = LockFreeSkipList<int, std::string, std::less<int>, QSBRManager>;
+using QsbrHashMap  = LockFreeHashMap<int, int, std::hash<int>, std::equal_to<int>, QSBRManager>;
+
+// ============================================================================
+// --- 测试夹具 (Fixture) ---
+// ============================================================================
+class QSBRManagerTest : public ThreadHeapTestFixture {
+protected:
+    void retireTracked(std::atomic<size_t>* counter) {
+        void* mem = ThreadHeap::allocate(sizeof(QsbrTrackedObject));
+        qsbr_.retire(new(mem) QsbrTrackedObject(counter));
+    }
+
+    QSBRManager qsbr_;
+};
+
+// ============================================================================
+// --- 测试用例 ---
+// ============================================================================
+
+// 1) 单线程：退休后经过两次纪元推进（几次 quiescent）才释放
+TEST_F(QSBRManagerTest, QuiescentReclaimsAfterGracePeriod) {
+    std::atomic<size_t> counter = 0;
+
+    {
+        ebr::Guard guard(qsbr_);
+        retireTracked(&counter);
+    }
+    EXPECT_EQ(counter.load(), 0u); // leave 不做任何事
+
+    for (size_t i = 0; i < QSBRManager::kNumEpochLists; ++i) {
+        qsbr_.quiescent();
+    }
+    EXPECT_EQ(counter.load(), 1u);
+}
+
+// 2) 在线但不报告静止状态的线程会阻止回收；下线后回收继续
+TEST_F(QSBRManagerTest, OnlineReaderBlocksUntilOffline) {
+    std::atomic<size_t> counter = 0;
+    std::atomic<bool> reader_online{false};
+    std::atomic<bool> go_offline{false};
+    std::atomic<bool> reader_offline{false};
+    std::atomic<bool> finish{false};
+
+    std::thread reader([&]() {
+        qsbr_.online();
+        reader_online.store(true, std::memory_order_release);
+        while (!go_offline.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        qsbr_.offline();
+        reader_offline.store(true, std::memory_order_release);
+        // 保持线程存活：验证的是 offline 本身，而不是线程退出
+        while (!finish.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    });
+    while (!reader_online.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+
+    qsbr_.online();
+    retireTracked(&counter);
+    for (int i = 0; i < 100; ++i) {
+        qsbr_.quiescent();
+    }
+    EXPECT_EQ(counter.load(), 0u);
+
+    go_offline.store(true, std::memory_order_release);
+    while (!reader_offline.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+    for (size_t i = 0; i < QSBRManager::kNumEpochLists; ++i) {
+        qsbr_.quiescent();
+    }
+    EXPECT_EQ(counter.load(), 1u);
+
+    finish.store(true, std::memory_order_release);
+    reader.join();
+}
+
+// 3) 在线线程退出时自动下线，不会永久阻塞纪元
+TEST_F(QSBRManagerTest, ExitedThreadGoesOffline) {
+    std::atomic<size_t> counter = 0;
+
+    std::thread worker([&]() {
+        qsbr_.online();
+        retireTracked(&counter);
+    });
+    worker.join();
+
+    for (size_t i = 0; i < QSBRManager::kNumEpochLists + 1; ++i) {
+        qsbr_.quiescent();
+    }
+    EXPECT_EQ(counter.load(), 1u);
+}
+
+// 4) 作为跳表的回收器：并发插入 / 删除，每次操作后报告静止状态
+TEST_F(QSBRManagerTest, SkipListConcurrentWithQuiescentPoints) {
+    auto* manager = new (ThreadHeap::allocate(sizeof(QSBRManager))) QSBRManager();
+    auto* list = new (ThreadHeap::allocate(sizeof(QsbrSkipList))) QsbrSkipList(*manager);
+
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 500;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([manager, list, t]() {
+            for (int i = 0; i < kPerThread; ++i) {
+                const int key = t * kPerThread + i;
+                EXPECT_TRUE(list->insert(key, std::to_string(key)));
+                manager->quiescent();
+            }
+            for (int i = 0; i < kPerThread; i += 2) {
+                EXPECT_TRUE(list->remove(t * kPerThread + i));
+                manager->quiescent();
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    for (int key = 0; key < kThreads * kPerThread; ++key) {
+        std::string value;
+        EXPECT_EQ(list->find(key, value), key % 2 == 1) << "key " << key;
+    }
+
+    list->~QsbrSkipList();
+    ThreadHeap::deallocate(list);
+    manager->~QSBRManager();
+    ThreadHeap::deallocate(manager);
+}
+
+// 5) 作为哈希表的回收器：通过 getReclaimer 报告静止状态
+TEST_F(QSBRManagerTest, HashMapWithQsbrReclaimer) {
+    auto* map = new (ThreadHeap::allocate(sizeof(QsbrHashMap))) QsbrHashMap(64);
+
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 500;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([map, t]() {
+            for (int i = 0; i < kPerThread; ++i) {
+                const int key = t * kPerThread + i;
+                EXPECT_TRUE(map->insert(key, key * 10));
+                if (i % 2 == 0) {
+                    EXPECT_TRUE(map->remove(key));
+                }
+                map->getReclaimer().quiescent();
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+
+    for (int key = 0; key < kThreads * kPerThread; ++key) {
+        auto value = map->find(key);
+        if (key % 2 == 0) {
+            EXPECT_FALSE(value.has_value()) << "key " << key;
+        } else {
+            ASSERT_TRUE(value.has_value()) << "key " << key;
+            EXPECT_EQ(*value, key * 10);
+        }
+    }
+
+    map->~QsbrHashMap();
+    ThreadHeap::deallocate(map);
+}
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "fixtures/ShmTestFixture.hpp"
+#include "ShmBroadcastRing/ShmBroadcastRing.hpp"
+
+// ============================================================================
+// --- 类型别名 ---
+// ============================================================================
+// 模拟一条行情记录：序号 + 由序号推导出的校验字段
+struct Tick {
+    std::uint64_t seq;
+    std::uint64_t price;
+    std::uint64_t check;
+};
+
+inline Tick makeTick(std::uint64_t seq) { return Tick{seq, seq * 3 + 1, ~seq}; }
+inline bool isValid(const Tick& t) { return t.price == t.seq * 3 + 1 && t.check == ~t.seq; }
+
+using SmallRing = ShmBroadcastRing<Tick, 8>;
+using BigRing   = ShmBroadcastRing<Tick, 1024>;
+
+// ============================================================================
+// --- 测试夹具 (Fixture) ---
+// ============================================================================
+class ShmBroadcastRingFixture : public SharedMemoryTestFixture {
+protected:
+    template <class R>
+    R* createInShm() {
+        return new (segment->getHeapSection()) R();
+    }
+};
+
+// ============================================================================
+// --- 测试用例 ---
+// ============================================================================
+
+// 1) 空环：读不到任何记录
+TEST_F(ShmBroadcastRingFixture, Empty_ReadReturnsEmpty) {
+    auto* ring = createInShm<SmallRing>();
+
+    auto sub = ring->subscribe();
+    Tick out{};
+    EXPECT_EQ(ring->read(sub, out), SmallRing::ReadResult::kEmpty);
+    EXPECT_EQ(ring->getWritePosition(), 0u);
+
+    ring->~SmallRing();
+}
+
+// 2) 每个订阅者都能独立读到全部记录
+TEST_F(ShmBroadcastRingFixture, EverySubscriberSeesEveryRecord) {
+    auto* ring = createInShm<SmallRing>();
+
+    auto a = ring->subscribe();
+    auto b = ring->subscribe();
+    for (std::uint64_t i = 0; i < 5; ++i) {
+        ring->publish(makeTick(i));
+    }
+
+    Tick out{};
+    for (std::uint64_t i = 0; i < 5; ++i) {
+        ASSERT_EQ(ring->read(a, out), SmallRing::ReadResult::kOk);
+        EXPECT_EQ(out.seq, i);
+    }
+    EXPECT_EQ(ring->read(a, out), SmallRing::ReadResult::kEmpty);
+
+    for (std::uint64_t i = 0; i < 5; ++i) {
+        ASSERT_EQ(ring->read(b, out), SmallRing::ReadResult::kOk);
+        EXPECT_EQ(out.seq, i);
+    }
+    EXPECT_EQ(a.getLostCount(), 0u);
+    EXPECT_EQ(b.getLostCount(), 0u);
+
+    // 晚到的订阅者只看到订阅之后的记录
+    auto late = ring->subscribe();
+    EXPECT_EQ(ring->read(late, out), SmallRing::ReadResult::kEmpty);
+    ring->publish(makeTick(5));
+    ASSERT_EQ(ring->read(late, out), SmallRing::ReadResult::kOk);
+    EXPECT_EQ(out.seq, 5u);
+
+    ring->~SmallRing();
+}
+
+// 3) 慢读者被套圈：报告溢出并跳到最旧的有效记录，写者不受影响
+TEST_F(ShmBroadcastRingFixture, SlowSubscriber_DetectsOverrun) {
+    auto* ring = createInShm<SmallRing>();
+
+    auto sub = ring->subscribe();
+    for (std::uint64_t i = 0; i < 20; ++i) {
+        ring->publish(makeTick(i));
+    }
+
+    Tick out{};
+    EXPECT_EQ(ring->read(sub, out), SmallRing::ReadResult::kOverrun);
+    // 最旧的有效记录是 20 - 8 + 1 = 13
+    EXPECT_EQ(sub.getPosition(), 13u);
+    EXPECT_EQ(sub.getLostCount(), 13u);
+
+    for (std::uint64_t i = 13; i < 20; ++i) {
+        ASSERT_EQ(ring->read(sub, out), SmallRing::ReadResult::kOk);
+        EXPECT_EQ(out.seq, i);
+    }
+    EXPECT_EQ(ring->read(sub, out), SmallRing::ReadResult::kEmpty);
+
+    // subscribeFromOldest 从同一位置开始
+    EXPECT_EQ(ring->subscribeFromOldest().getPosition(), 13u);
+
+    ring->~SmallRing();
+}
+
+// 4) 并发：一个写者、多个读线程；读到的记录完整且序号严格递增
+TEST_F(ShmBroadcastRingFixture, ConcurrentOneWriterManyReaders) {
+    auto* ring = createInShm<BigRing>();
+    constexpr std::uint64_t kRecords = 200000;
+    constexpr int kReaders = 4;
+
+    std::atomic<int> ready{0};
+    std::atomic<bool> ok{true};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < kReaders; ++r) {
+        readers.emplace_back([&]() {
+            auto sub = ring->subscribe();
+            ready.fetch_add(1);
+            std::uint64_t last = 0;
+            bool first = true;
+            Tick out{};
+            while (first || last + 1 < kRecords) {
+                auto res = ring->read(sub, out);
+                if (res != BigRing::ReadResult::kOk) continue;
+                if (!isValid(out) || (!first && out.seq <= last)) {
+                    ok.store(false);
+                }
+                last  = out.seq;
+                first = false;
+            }
+            // 读到的 + 丢失的 = 全部
+            if (sub.getPosition() != kRecords) ok.store(false);
+        });
+    }
+
+    while (ready.load() < kReaders) {}
+    for (std::uint64_t i = 0; i < kRecords; ++i) {
+        ring->publish(makeTick(i));
+    }
+    for (auto& t : readers) t.join();
+    EXPECT_TRUE(ok.load());
+
+    ring->~BigRing();
+}
+
+// 5) 跨进程：多个子进程订阅，父进程写
+TEST_F(ShmBroadcastRingFixture, MultiProcess_FanOut) {
+    struct Shared {
+        BigRing ring;
+        std::atomic<int> ready;
+    };
+    auto* shared = new (segment->getHeapSection()) Shared{};
+    shared->ready.store(0, std::memory_order_relaxed);
+    constexpr std::uint64_t kRecords = 50000;
+    constexpr int kChildren = 3;
+
+    std::vector<pid_t> pids;
+    for (int c = 0; c < kChildren; ++c) {
+        pid_t pid = fork();
+        ASSERT_NE(pid, -1);
+        if (pid == 0) {
+            auto sub = shared->ring.subscribe();
+            shared->ready.fetch_add(1);
+            std::uint64_t received = 0;
+            bool ok = true;
+            Tick out{};
+            while (sub.getPosition() < kRecords) {
+                if (shared->ring.read(sub, out) != BigRing::ReadResult::kOk) continue;
+                ok = ok && isValid(out) && out.seq + 1 == sub.getPosition();
+                ++received;
+            }
+            ok = ok && received + sub.getLostCount() == kRecords;
+            _exit(ok ? 0 : 1);
+        }
+        pids.push_back(pid);
+    }
+
+    while (shared->ready.load() < kChildren) {}
+    for (std::uint64_t i = 0; i < kRecords; ++i) {
+        shared->ring.publish(makeTick(i));
+    }
+
+    for (pid_t pid : pids) {
+        int st = 0;
+        ASSERT_EQ(waitpid(pid, &st, 0), pid);
+        EXPECT_TRUE(WIFEXITED(st) && WEXITSTATUS(st) == 0);
+    }
+
+    shared->~Shared();
+}
@@ -0,0 +1,229 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "fixtures/ShmTestFixture.hpp"
+#include "ShmByteRing/ShmByteRing.hpp"
+
+// ============================================================================
+// --- 类型别名 ---
+// ============================================================================
+using SmallRing = ShmByteRing<256>;
+using BigRing   = ShmByteRing<1u << 20>;
+
+// ============================================================================
+// --- 测试夹具 (Fixture) ---
+// ============================================================================
+class ShmByteRingFixture : public SharedMemoryTestFixture {
+protected:
+    template <class R>
+    R* createInShm() {
+        return new (segment->getHeapSection()) R();
+    }
+};
+
+namespace {
+// 第 seq 条消息的长度与内容都由 seq 决定，消费者可以据此校验
+std::size_t messageSize(std::uint32_t seq, std::size_t max_size) {
+    return 40 + (static_cast<std::size_t>(seq) * 7919u) % (max_size - 40);
+}
+
+void fillMessage(void* dst, std::uint32_t seq, std::size_t size) {
+    auto* bytes = static_cast<unsigned char*>(dst);
+    std::memcpy(bytes, &seq, sizeof(seq));
+    for (std::size_t i = sizeof(seq); i < size; ++i) {
+        bytes[i] = static_cast<unsigned char>(seq + i);
+    }
+}
+
+bool checkMessage(const void* src, std::uint32_t seq, std::size_t size) {
+    auto* bytes = static_cast<const unsigned char*>(src);
+    std::uint32_t stored = 0;
+    std::memcpy(&stored, bytes, sizeof(stored));
+    if (stored != seq) return false;
+    for (std::size_t i = sizeof(seq); i < size; ++i) {
+        if (bytes[i] != static_cast<unsigned char>(seq + i)) return false;
+    }
+    return true;
+}
+} // namespace
+
+// ============================================================================
+// --- 测试用例 ---
+// ============================================================================
+
+// 1) 空缓冲区
+TEST_F(ShmByteRingFixture, Empty_PeekFalse) {
+    auto* ring = createInShm<SmallRing>();
+
+    SmallRing::Record rec;
+    EXPECT_TRUE(ring->isEmpty());
+    EXPECT_FALSE(ring->peek(rec));
+
+    ring->~SmallRing();
+}
+
+// 2) 原地写入、原地读取：peek 返回的指针就是 reserve 写入的位置
+TEST_F(ShmByteRingFixture, ReserveCommitPeekRelease_ZeroCopy) {
+    auto* ring = createInShm<SmallRing>();
+
+    void* w = ring->reserve(13);
+    ASSERT_NE(w, nullptr);
+    std::memcpy(w, "hello, world", 13);
+
+    SmallRing::Record rec;
+    EXPECT_FALSE(ring->peek(rec)) << "uncommitted data must not be visible";
+
+    ring->commit();
+    ASSERT_TRUE(ring->peek(rec));
+    EXPECT_EQ(rec.data, w);
+    EXPECT_EQ(rec.size, 13u);
+    EXPECT_STREQ(static_cast<const char*>(rec.data), "hello, world");
+
+    // peek 不出队
+    SmallRing::Record again;
+    ASSERT_TRUE(ring->peek(again));
+    EXPECT_EQ(again.data, rec.data);
+
+    ring->release();
+    EXPECT_FALSE(ring->peek(rec));
+    EXPECT_TRUE(ring->isEmpty());
+
+    ring->~SmallRing();
+}
+
+// 3) 尾部放不下时插入填充记录，记录本体保持连续
+TEST_F(ShmByteRingFixture, WrapAround_UsesPaddingRecord) {
+    auto* ring = createInShm<SmallRing>();
+    SmallRing::Record rec;
+
+    // 100 字节负载 -> 每条记录占 112 字节；第三条必须绕回开头
+    for (std::uint32_t seq = 0; seq < 10; ++seq) {
+        void* w = ring->reserve(100);
+        ASSERT_NE(w, nullptr) << "seq " << seq;
+        fillMessage(w, seq, 100);
+        ring->commit();
+
+        ASSERT_TRUE(ring->peek(rec));
+        EXPECT_EQ(rec.size, 100u);
+        EXPECT_TRUE(checkMessage(rec.data, seq, rec.size));
+        ring->release();
+    }
+    EXPECT_TRUE(ring->isEmpty());
+
+    ring->~SmallRing();
+}
+
+// 4) 空间不足 / 超过单条上限时 reserve 失败
+TEST_F(ShmByteRingFixture, Reserve_FailsWhenFullOrTooLarge) {
+    auto* ring = createInShm<SmallRing>();
+
+    EXPECT_EQ(ring->reserve(SmallRing::maxRecordSize() + 1), nullptr);
+
+    ASSERT_NE(ring->reserve(100), nullptr);
+    ring->commit();
+    ASSERT_NE(ring->reserve(100), nullptr);
+    ring->commit();
+    // 已用 224 字节，再放一条 112 字节的记录放不下
+    EXPECT_EQ(ring->reserve(100), nullptr);
+
+    SmallRing::Record rec;
+    ASSERT_TRUE(ring->peek(rec));
+    ring->release();
+    EXPECT_NE(ring->reserve(100), nullptr);
+
+    ring->~SmallRing();
+}
+
+// 5) commit(used) 只发布实际写入的长度
+TEST_F(ShmByteRingFixture, CommitShrinksRecord) {
+    auto* ring = createInShm<SmallRing>();
+
+    void* w = ring->reserve(120);
+    ASSERT_NE(w, nullptr);
+    fillMessage(w, 7, 48);
+    ring->commit(48);
+    EXPECT_EQ(ring->bytesInUse(), 56u);
+
+    SmallRing::Record rec;
+    ASSERT_TRUE(ring->peek(rec));
+    EXPECT_EQ(rec.size, 48u);
+    EXPECT_TRUE(checkMessage(rec.data, 7, 48));
+    ring->release();
+
+    ring->~SmallRing();
+}
+
+// 6) 并发 SPSC：40B ~ 64KiB 的变长消息
+TEST_F(ShmByteRingFixture, ConcurrentSPSC_VariableLengthMessages) {
+    auto* ring = createInShm<BigRing>();
+    constexpr std::uint32_t kMessages = 20000;
+    constexpr std::size_t kMaxMsg = 64 * 1024;
+
+    std::thread producer([ring]() {
+        for (std::uint32_t seq = 0; seq < kMessages; ++seq) {
+            const std::size_t size = messageSize(seq, kMaxMsg);
+            void* w = nullptr;
+            while ((w = ring->reserve(size)) == nullptr) {
+                std::this_thread::yield();
+            }
+            fillMessage(w, seq, size);
+            ring->commit();
+        }
+    });
+
+    std::uint32_t expected = 0;
+    BigRing::Record rec;
+    while (expected < kMessages) {
+        if (!ring->peek(rec)) continue;
+        ASSERT_EQ(rec.size, messageSize(expected, kMaxMsg));
+        ASSERT_TRUE(checkMessage(rec.data, expected, rec.size)) << "seq " << expected;
+        ring->release();
+        ++expected;
+    }
+    producer.join();
+    EXPECT_TRUE(ring->isEmpty());
+
+    ring->~BigRing();
+}
+
+// 7) 跨进程：子进程生产，父进程消费
+TEST_F(ShmByteRingFixture, MultiProcess_ProducerInChild) {
+    auto* ring = createInShm<BigRing>();
+    constexpr std::uint32_t kMessages = 5000;
+    constexpr std::size_t kMaxMsg = 16 * 1024;
+
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+        for (std::uint32_t seq = 0; seq < kMessages; ++seq) {
+            const std::size_t size = messageSize(seq, kMaxMsg);
+            void* w = nullptr;
+            while ((w = ring->reserve(size)) == nullptr) {}
+            fillMessage(w, seq, size);
+            ring->commit();
+        }
+        _exit(0);
+    }
+
+    std::uint32_t expected = 0;
+    bool ok = true;
+    BigRing::Record rec;
+    while (expected < kMessages) {
+        if (!ring->peek(rec)) continue;
+        ok = ok && rec.size == messageSize(expected, kMaxMsg) &&
+             checkMessage(rec.data, expected, rec.size);
+        ring->release();
+        ++expected;
+    }
+    EXPECT_TRUE(ok);
+
+    int st = 0;
+    ASSERT_EQ(waitpid(pid, &st, 0), pid);
+    EXPECT_TRUE(WIFEXITED(st) && WEXITSTATUS(st) == 0);
+
+    ring->~BigRing();
+}
@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "fixtures/ThreadHeapTestFixture.hpp"
+#include "EBRManager/ShmEBRDomain.hpp"
+#include "EBRManager/ShmEBRManager.hpp"
+#include "EBRManager/guard.hpp"
+
+// ============================================================================
+// --- 测试辅助工具 ---
+// ============================================================================
+// 计数器放在共享内存里，父子进程都能看到析构次数
+struct ShmTrackedObject {
+    std::atomic<size_t>* destruction_counter;
+
+    explicit ShmTrackedObject(std::atomic<size_t>* counter) : destruction_counter(counter) {}
+
+    ~ShmTrackedObject() {
+        destruction_counter->fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+// 父子进程之间的同步标志，也放在共享内存里
+struct ShmTestControl {
+    std::atomic<size_t> counter{0};
+    std::atomic<int> phase{0};
+};
+
+// ============================================================================
+// --- 测试夹具 (Fixture) ---
+// ============================================================================
+class ShmEBRManagerTest : public ThreadHeapTestFixture {
+protected:
+    void SetUp() override {
+        domain_  = new (ThreadHeap::allocate(sizeof(ShmEBRDomain))) ShmEBRDomain();
+        control_ = new (ThreadHeap::allocate(sizeof(ShmTestControl))) ShmTestControl();
+    }
+
+    void TearDown() override {
+        control_->~ShmTestControl();
+        ThreadHeap::deallocate(control_);
+        domain_->~ShmEBRDomain();
+        ThreadHeap::deallocate(domain_);
+    }
+
+    static void waitPhase(ShmTestControl* control, int phase) {
+        while (control->phase.load(std::memory_order_acquire) != phase) {
+            std::this_thread::yield();
+        }
+    }
+
+    ShmEBRDomain* domain_ = nullptr;
+    ShmTestControl* control_ = nullptr;
+};
+
+// ============================================================================
+// --- 测试用例 ---
+// ============================================================================
+
+// 1) 单进程：与 EBRManager 相同的回收时机，槽位在析构时归还
+TEST_F(ShmEBRManagerTest, SingleProcessRetireAndReclaim) {
+    {
+        ShmEBRManager manager(*domain_);
+        {
+            ebr::Guard guard(manager);
+            void* mem = ThreadHeap::allocate(sizeof(ShmTrackedObject));
+            manager.retire(new(mem) ShmTrackedObject(&control_->counter));
+        }
+        EXPECT_EQ(control_->counter.load(), 0u);
+        EXPECT_EQ(domain_->getUsedSlotCount(), 1u);
+
+        for (size_t i = 0; i < ShmEBRManager::kNumEpochLists; ++i) {
+            manager.enter();
+            manager.leave();
+        }
+        EXPECT_EQ(control_->counter.load(), 1u);
+    }
+    EXPECT_EQ(domain_->getUsedSlotCount(), 0u);
+}
+
+// 2) 线程退出时归还槽位
+TEST_F(ShmEBRManagerTest, ThreadExitReleasesSlot) {
+    ShmEBRManager manager(*domain_);
+    std::thread worker([&]() {
+        ebr::Guard guard(manager);
+        EXPECT_EQ(domain_->getUsedSlotCount(), 1u);
+    });
+    worker.join();
+    EXPECT_EQ(domain_->getUsedSlotCount(), 0u);
+}
+
+// 3) 另一个进程的读者会阻止回收；它离开后回收继续
+TEST_F(ShmEBRManagerTest, ReaderInOtherProcessBlocksReclaim) {
+    ShmEBRDomain* domain = domain_;
+    ShmTestControl* control = control_;
+
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+        int rc = 0;
+        // 子进程在新线程里工作：拿到独立的 ThreadHeap 线程缓存
+        std::thread child([&]() {
+            ShmEBRManager manager(*domain);
+            waitPhase(control, 1); // 父进程已进入临界区
+
+            manager.enter();
+            void* mem = ThreadHeap::allocate(sizeof(ShmTrackedObject));
+            manager.retire(new(mem) ShmTrackedObject(&control->counter));
+            manager.leave();
+            for (int i = 0; i < 100; ++i) {
+                manager.enter();
+                manager.leave();
+            }
+            if (control->counter.load() != 0) rc = 1;
+
+            control->phase.store(2, std::memory_order_release);
+            waitPhase(control, 3); // 父进程已离开
+
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (control->counter.load() == 0 && std::chrono::steady_clock::now() < deadline) {
+                manager.enter();
+                manager.leave();
+            }
+            if (control->counter.load() != 1) rc = 2;
+        });
+        child.join();
+        _exit(rc);
+    }
+
+    ShmEBRManager manager(*domain_);
+    manager.enter();
+    control_->phase.store(1, std::memory_order_release);
+    waitPhase(control_, 2);
+    EXPECT_EQ(control_->counter.load(), 0u);
+    manager.leave();
+    control_->phase.store(3, std::memory_order_release);
+
+    int st = 0;
+    ASSERT_EQ(waitpid(pid, &st, 0), pid);
+    EXPECT_TRUE(WIFEXITED(st));
+    EXPECT_EQ(WEXITSTATUS(st), 0);
+}
+
+// 4) 在临界区内崩溃的进程：槽位被回收，不会永久阻塞纪元
+TEST_F(ShmEBRManagerTest, CrashedProcessDoesNotBlockReclaim) {
+    ShmEBRDomain* domain = domain_;
+    ShmTestControl* control = control_;
+
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+        ShmEBRManager* manager = new ShmEBRManager(*domain); // 故意不析构
+        manager->enter();
+        control->phase.store(1, std::memory_order_release);
+        waitPhase(control, 2);
+        _exit(0); // 不 leave、不归还槽位
+    }
+    waitPhase(control_, 1);
+
+    ShmEBRManager manager(*domain_);
+    manager.enter();
+    void* mem = ThreadHeap::allocate(sizeof(ShmTrackedObject));
+    manager.retire(new(mem) ShmTrackedObject(&control_->counter));
+    manager.leave();
+    for (int i = 0; i < 100; ++i) {
+        manager.enter();
+        manager.leave();
+    }
+    EXPECT_EQ(control_->counter.load(), 0u); // 子进程仍活着并停在临界区内
+
+    control_->phase.store(2, std::memory_order_release);
+    int st = 0;
+    ASSERT_EQ(waitpid(pid, &st, 0), pid);
+
+    for (size_t i = 0; i < ShmEBRManager::kNumEpochLists; ++i) {
+        manager.enter();
+        manager.leave();
+    }
+    EXPECT_EQ(control_->counter.load(), 1u);
+    EXPECT_EQ(domain_->getUsedSlotCount(), 1u); // 只剩本进程的槽位
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "fixtures/ThreadHeapTestFixture.hpp"
+#include "Tool/ShmEventCount.hpp"
+#include "LockFreeStack/LockFreeStack.hpp"
+#include "LockFreeQueue/LockFreeQueue.hpp"
+#include "Hazard/HazardPointerOrganizer.hpp"
+
+using namespace std::chrono_literals;
+
+// ============================================================================
+// --- 类型别名 ---
+// ============================================================================
+using Stack            = LockFreeStack<int>;
+using StackHpOrganizer = HazardPointerOrganizer<StackNode<int>, Stack::kHazardPointers>;
+using Queue            = LockFreeQueue<int>;
+using QueueHpOrganizer = HazardPointerOrganizer<QueueNode<int>, Queue::kHazardPointers>;
+
+// ============================================================================
+// --- 测试夹具 (Fixture) ---
+// ============================================================================
+class ShmEventCountFixture : public ThreadHeapTestFixture {};
+
+// ============================================================================
+// --- 测试用例 ---
+// ============================================================================
+
+// 1) 没有 notify 时 wait 超时返回 false，并注销等待者
+TEST_F(ShmEventCountFixture, Wait_TimesOutWithoutNotify) {
+    ShmEventCount ec;
+
+    auto key = ec.prepareWait();
+    EXPECT_EQ(ec.getWaiterCount(), 1u);
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(ec.wait(key, 20ms));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+    EXPECT_EQ(ec.getWaiterCount(), 0u);
+}
+
+// 2) prepareWait 之后的 notify 不会丢失（即使发生在真正挂起之前）
+TEST_F(ShmEventCountFixture, NotifyBetweenPrepareAndWait_NotLost) {
+    ShmEventCount ec;
+
+    auto key = ec.prepareWait();
+    ec.notifyOne();
+    EXPECT_TRUE(ec.wait(key, 1s));
+    EXPECT_EQ(ec.getWaiterCount(), 0u);
+}
+
+// 3) await：挂起的消费者被另一个线程唤醒
+TEST_F(ShmEventCountFixture, Await_WokenByProducerThread) {
+    ShmEventCount ec;
+    std::atomic<int> flag{0};
+
+    std::thread producer([&]() {
+        std::this_thread::sleep_for(30ms);
+        flag.store(1, std::memory_order_release);
+        ec.notifyAll();
+    });
+
+    EXPECT_TRUE(ec.await([&]() { return flag.load(std::memory_order_acquire) == 1; }, 5s));
+    producer.join();
+    EXPECT_EQ(ec.getWaiterCount(), 0u);
+}
+
+// 4) 跨进程：父进程挂起在共享内存中的事件计数器上，子进程唤醒
+TEST_F(ShmEventCountFixture, MultiProcess_ChildWakesParent) {
+    struct Shared {
+        ShmEventCount    ec;
+        std::atomic<int> flag;
+    };
+    // ThreadHeap 的内存位于共享映射中，fork 出的子进程看到的是同一份对象
+    void* mem = ThreadHeap::allocate(sizeof(Shared));
+    ASSERT_NE(mem, nullptr);
+    auto* shared = new (mem) Shared{};
+    shared->flag.store(0, std::memory_order_relaxed);
+
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+        std::this_thread::sleep_for(30ms);
+        shared->flag.store(1, std::memory_order_release);
+        shared->ec.notifyAll();
+        _exit(0);
+    }
+
+    EXPECT_TRUE(shared->ec.await(
+        [&]() { return shared->flag.load(std::memory_order_acquire) == 1; }, 5s));
+
+    int st = 0;
+    ASSERT_EQ(waitpid(pid, &st, 0), pid);
+    EXPECT_TRUE(WIFEXITED(st) && WEXITSTATUS(st) == 0);
+
+    shared->~Shared();
+    ThreadHeap::deallocate(shared);
+}
+
+// 5) 栈：空栈 pop(timeout) 超时；有数据时立即返回
+TEST_F(ShmEventCountFixture, StackPop_TimeoutAndFastPath) {
+    auto* hp_organizer = new (ThreadHeap::allocate(sizeof(StackHpOrganizer))) StackHpOrganizer();
+    auto* st           = new (ThreadHeap::allocate(sizeof(Stack))) Stack(*hp_organizer);
+
+    int out = 0;
+    EXPECT_FALSE(st->pop(out, 10ms));
+
+    st->push(42);
+    ASSERT_TRUE(st->pop(out, 0ms));
+    EXPECT_EQ(out, 42);
+
+    st->~Stack();
+    ThreadHeap::deallocate(st);
+    hp_organizer->~StackHpOrganizer();
+    ThreadHeap::deallocate(hp_organizer);
+}
+
+// 6) 队列：阻塞消费者按 FIFO 收到生产者稍后推入的全部元素
+TEST_F(ShmEventCountFixture, QueuePop_BlockingConsumer) {
+    auto* hp_organizer = new (ThreadHeap::allocate(sizeof(QueueHpOrganizer))) QueueHpOrganizer();
+    auto* q            = new (ThreadHeap::allocate(sizeof(Queue))) Queue(*hp_organizer);
+    constexpr int kItems = 2000;
+
+    std::thread producer([q]() {
+        for (int i = 0; i < kItems; ++i) {
+            if (i % 100 == 0) {
+                std::this_thread::sleep_for(1ms); // 让消费者有机会真正挂起
+            }
+            q->push(i);
+        }
+    });
+
+    int out = -1;
+    for (int expect = 0; expect < kItems; ++expect) {
+        ASSERT_TRUE(q->pop(out, 5s));
+        EXPECT_EQ(out, expect);
+    }
+    producer.join();
+    EXPECT_TRUE(q->isEmpty());
+
+    q->~Queue();
+    ThreadHeap::deallocate(q);
+    hp_organizer->~QueueHpOrganizer();
+    ThreadHeap::deallocate(hp_organizer);
+}
@@ -0,0 +1,224 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <type_traits>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "fixtures/ThreadHeapTestFixture.hpp"
+#include "Hazard/ShmHazardDomain.hpp"
+#include "Hazard/ShmHazardOrganizer.hpp"
+#include "LockFreeStack/LockFreeStack.hpp"
+
+// ============================================================================
+// --- 测试辅助工具 ---
+// ============================================================================
+// 计数器放在共享内存里，父子进程都能看到析构次数
+struct ShmTrackedHazardNode : public GCHook {
+    std::atomic<size_t>* destruction_counter;
+
+    explicit ShmTrackedHazardNode(std::atomic<size_t>* counter) : destruction_counter(counter) {}
+
+    ~ShmTrackedHazardNode() override {
+        destruction_counter->fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+// 父子进程之间的同步标志，也放在共享内存里
+struct ShmHazardTestControl {
+    std::atomic<size_t> counter{0};
+    std::atomic<int> phase{0};
+    std::atomic<size_t> popped{0};
+    std::atomic<long long> popped_sum{0};
+};
+
+using TrackedOrganizer = ShmHazardOrganizer<ShmTrackedHazardNode, 1>;
+using TrackedDomain    = TrackedOrganizer::Domain;
+
+using ShmStackOrganizer = ShmHazardOrganizer<StackNode<int>, 1>;
+using ShmStackDomain    = ShmStackOrganizer::Domain;
+
+// 域绑定节点类型：别的进程会按域的 Node 释放孤儿节点，不能挂接管理其他节点类型的管理器
+static_assert(!std::is_constructible<ShmStackOrganizer, TrackedDomain&>::value,
+              "a domain must only serve organizers of its own node type");
+using ShmStack          = LockFreeStack<int, DefaultHeapPolicy, ShmStackOrganizer>;
+
+// ============================================================================
+// --- 测试夹具 (Fixture) ---
+// ============================================================================
+class ShmHazardOrganizerTest : public ThreadHeapTestFixture {
+protected:
+    void SetUp() override {
+        domain_  = new (ThreadHeap::allocate(sizeof(TrackedDomain))) TrackedDomain();
+        control_ = new (ThreadHeap::allocate(sizeof(ShmHazardTestControl))) ShmHazardTestControl();
+    }
+
+    void TearDown() override {
+        control_->~ShmHazardTestControl();
+        ThreadHeap::deallocate(control_);
+        domain_->~TrackedDomain();
+        ThreadHeap::deallocate(domain_);
+    }
+
+    static void waitPhase(ShmHazardTestControl* control, int phase) {
+        while (control->phase.load(std::memory_order_acquire) != phase) {
+            std::this_thread::yield();
+        }
+    }
+
+    ShmTrackedHazardNode* makeNode() {
+        void* mem = ThreadHeap::allocate(sizeof(ShmTrackedHazardNode));
+        return new (mem) ShmTrackedHazardNode(&control_->counter);
+    }
+
+    TrackedDomain* domain_ = nullptr;
+    ShmHazardTestControl* control_ = nullptr;
+};
+
+// ============================================================================
+// --- 测试用例 ---
+// ============================================================================
+
+// 1) 单进程：受保护的节点不释放，清除后 collect 释放；析构时归还槽位
+TEST_F(ShmHazardOrganizerTest, SingleProcessProtectRetireCollect) {
+    {
+        TrackedOrganizer organizer(*domain_);
+        auto* slot = organizer.acquireTlsSlot();
+        ASSERT_NE(slot, nullptr);
+        EXPECT_EQ(domain_->getSlotOwner(slot->getIndex()), ::getpid());
+
+        ShmTrackedHazardNode* protected_node = makeNode();
+        slot->protect(0, protected_node);
+        organizer.retire(protected_node);
+        organizer.retire(makeNode());
+
+        EXPECT_EQ(organizer.collect(), 1u);
+        EXPECT_EQ(control_->counter.load(), 1u);
+
+        slot->clear(0);
+        EXPECT_EQ(organizer.collect(), 1u);
+        EXPECT_EQ(control_->counter.load(), 2u);
+        EXPECT_EQ(domain_->getUsedSlotCount(), 1u);
+    }
+    EXPECT_EQ(domain_->getUsedSlotCount(), 0u);
+}
+
+// 2) 另一个进程的危险指针阻止回收；崩溃后它的槽位被回收，节点随之释放
+TEST_F(ShmHazardOrganizerTest, CrashedProcessHazardIsReaped) {
+    TrackedDomain* domain = domain_;
+    ShmHazardTestControl* control = control_;
+    ShmTrackedHazardNode* node = makeNode();
+
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+        // 子进程在新线程里工作：拿到独立的 ThreadHeap 线程缓存
+        std::thread child([&]() {
+            TrackedOrganizer* organizer = new TrackedOrganizer(*domain); // 故意不析构
+            organizer->acquireTlsSlot()->protect(0, node);
+            // 子进程也退休一个节点：崩溃后由父进程接手
+            void* mem = ThreadHeap::allocate(sizeof(ShmTrackedHazardNode));
+            organizer->retire(new (mem) ShmTrackedHazardNode(&control->counter));
+            control->phase.store(1, std::memory_order_release);
+            waitPhase(control, 2);
+            _exit(0); // 线程不退出：不清除危险指针、不归还槽位
+        });
+        child.join();
+        _exit(1);
+    }
+    waitPhase(control_, 1);
+
+    TrackedOrganizer organizer(*domain_);
+    organizer.retire(node);
+    organizer.collect();
+    EXPECT_EQ(control_->counter.load(), 0u); // 子进程仍活着并保护着 node
+    EXPECT_EQ(domain_->getUsedSlotCount(), 2u);
+
+    control_->phase.store(2, std::memory_order_release);
+    int st = 0;
+    ASSERT_EQ(waitpid(pid, &st, 0), pid);
+
+    EXPECT_EQ(organizer.collect(), 2u);
+    EXPECT_EQ(control_->counter.load(), 2u);
+    EXPECT_EQ(domain_->getUsedSlotCount(), 1u); // 只剩本进程的槽位
+}
+
+// 3) 共享内存中的栈：两个进程并发出栈，每个元素恰好被取出一次，退休节点跨进程回收
+TEST_F(ShmHazardOrganizerTest, StackSharedAcrossProcesses) {
+    constexpr int kItems = 20000;
+    auto* stack_domain = new (ThreadHeap::allocate(sizeof(ShmStackDomain))) ShmStackDomain();
+    {
+        // 管理器在 fork 之前构造：子进程的副本与它地址相同，栈里的引用在两边都有效
+        ShmStackOrganizer organizer(*stack_domain);
+        auto* stack = new (ThreadHeap::allocate(sizeof(ShmStack))) ShmStack(organizer);
+        for (int i = 1; i <= kItems; ++i) {
+            stack->push(i);
+        }
+
+        ShmHazardTestControl* control = control_;
+        auto drain = [stack, control]() {
+            int v = 0;
+            while (control->popped.load(std::memory_order_relaxed) < static_cast<size_t>(kItems)) {
+                if (stack->tryPop(v)) {
+                    control->popped.fetch_add(1, std::memory_order_relaxed);
+                    control->popped_sum.fetch_add(v, std::memory_order_relaxed);
+                }
+            }
+        };
+
+        pid_t pid = fork();
+        ASSERT_NE(pid, -1);
+        if (pid == 0) {
+            std::thread child(drain);
+            child.join();
+            _exit(0);
+        }
+        drain();
+
+        int st = 0;
+        ASSERT_EQ(waitpid(pid, &st, 0), pid);
+        EXPECT_TRUE(WIFEXITED(st));
+        EXPECT_EQ(control_->popped.load(), static_cast<size_t>(kItems));
+        EXPECT_EQ(control_->popped_sum.load(), static_cast<long long>(kItems) * (kItems + 1) / 2);
+        EXPECT_TRUE(stack->isEmpty());
+
+        stack->~ShmStack();
+        ThreadHeap::deallocate(stack);
+        organizer.collect();
+        // 两个进程都已停止访问：剩余的退休节点全部释放，包括子进程留下的
+        organizer.drainAllRetired();
+        EXPECT_EQ(stack_domain->getUsedSlotCount(), 1u);
+    }
+    EXPECT_EQ(stack_domain->getUsedSlotCount(), 0u);
+    stack_domain->~ShmStackDomain();
+    ThreadHeap::deallocate(stack_domain);
+}
+
+// 4) 域内预算：超出预算的 retire 代为回收同一域上另一个存活线程积压的节点
+TEST_F(ShmHazardOrganizerTest, BudgetHelpReclaimsOtherLiveThreads) {
+    constexpr std::size_t kOtherRetired = 40;   // 远低于自动扫描阈值，对方自己不会回收
+    static_assert(kOtherRetired < TrackedOrganizer::getScanThreshold(), "must stay below the scan threshold");
+
+    TrackedOrganizer organizer(*domain_);
+    ShmTrackedHazardNode* mine = makeNode();
+
+    std::thread other([&]() {
+        for (std::size_t i = 0; i < kOtherRetired; ++i) {
+            organizer.retire(makeNode());
+        }
+        control_->phase.store(1, std::memory_order_release);
+        waitPhase(control_, 2);
+    });
+    waitPhase(control_, 1);
+    EXPECT_EQ(organizer.getRetiredNodes(), kOtherRetired);
+
+    organizer.setRetireBudget(kOtherRetired / 2, 0);
+    organizer.retire(mine);
+    EXPECT_EQ(organizer.getRetiredNodes(), 0u);
+    EXPECT_EQ(organizer.getBudgetOverrunCount(), 0u);
+    EXPECT_EQ(control_->counter.load(), kOtherRetired + 1);
+
+    control_->phase.store(2, std::memory_order_release);
+    other.join();
+}
@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "fixtures/ShmTestFixture.hpp"
+#include "ShmSeqlock/ShmSeqlock.hpp"
+
+// ============================================================================
+// --- 类型别名 ---
+// ============================================================================
+// 所有字段总是写成同一个值，读者只要读到“混合”的快照就能发现
+struct Config {
+    std::uint64_t version;
+    std::uint64_t fields[7];
+};
+
+inline Config makeConfig(std::uint64_t v) {
+    Config c{};
+    c.version = v;
+    for (auto& f : c.fields) f = v;
+    return c;
+}
+
+inline bool isConsistent(const Config& c) {
+    for (auto f : c.fields) {
+        if (f != c.version) return false;
+    }
+    return true;
+}
+
+// 较大的状态表，用双缓冲版本
+struct BigTable {
+    std::uint64_t version;
+    std::uint64_t rows[512];
+};
+
+inline bool isConsistent(const BigTable& t) {
+    for (auto r : t.rows) {
+        if (r != t.version) return false;
+    }
+    return true;
+}
+
+using ConfigLock = ShmSeqlock<Config>;
+using TableLock  = ShmDoubleBufferedSeqlock<BigTable>;
+
+// ============================================================================
+// --- 测试夹具 (Fixture) ---
+// ============================================================================
+class ShmSeqlockFixture : public SharedMemoryTestFixture {
+protected:
+    template <class L, class... Args>
+    L* createInShm(Args&&... args) {
+        return new (segment->getHeapSection()) L(std::forward<Args>(args)...);
+    }
+};
+
+// ============================================================================
+// --- 测试用例 ---
+// ============================================================================
+
+// 1) 单线程读写与序号
+TEST_F(ShmSeqlockFixture, StoreThenLoad) {
+    auto* lock = createInShm<ConfigLock>(makeConfig(1));
+
+    EXPECT_EQ(lock->load().version, 1u);
+    EXPECT_EQ(lock->getSequence(), 0u);
+
+    lock->store(makeConfig(2));
+    EXPECT_EQ(lock->getSequence(), 2u);
+
+    Config out{};
+    ASSERT_TRUE(lock->tryLoad(out));
+    EXPECT_EQ(out.version, 2u);
+    EXPECT_TRUE(isConsistent(out));
+
+    lock->~ConfigLock();
+}
+
+// 2) update 在写权限内原地修改
+TEST_F(ShmSeqlockFixture, UpdateInPlace) {
+    auto* lock = createInShm<ConfigLock>(makeConfig(5));
+
+    lock->update([](Config& c) { c = makeConfig(c.version + 1); });
+    Config out = lock->load();
+    EXPECT_EQ(out.version, 6u);
+    EXPECT_TRUE(isConsistent(out));
+
+    lock->~ConfigLock();
+}
+
+// 3) 多个写者互斥：每次 update 都不会丢
+TEST_F(ShmSeqlockFixture, ConcurrentWriters_Serialized) {
+    auto* lock = createInShm<ConfigLock>(makeConfig(0));
+    constexpr int kWriters = 4;
+    constexpr int kUpdates = 20000;
+
+    std::vector<std::thread> writers;
+    for (int w = 0; w < kWriters; ++w) {
+        writers.emplace_back([lock]() {
+            for (int i = 0; i < kUpdates; ++i) {
+                lock->update([](Config& c) { c = makeConfig(c.version + 1); });
+            }
+        });
+    }
+    for (auto& t : writers) t.join();
+
+    Config out = lock->load();
+    EXPECT_EQ(out.version, static_cast<std::uint64_t>(kWriters) * kUpdates);
+    EXPECT_TRUE(isConsistent(out));
+
+    lock->~ConfigLock();
+}
+
+// 4) 读者与写者并发：读到的快照总是一致的，版本单调不减
+TEST_F(ShmSeqlockFixture, ConcurrentReaders_SeeConsistentSnapshots) {
+    auto* lock = createInShm<ConfigLock>(makeConfig(0));
+    constexpr std::uint64_t kUpdates = 100000;
+    constexpr int kReaders = 4;
+
+    std::atomic<bool> done{false};
+    std::atomic<bool> ok{true};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < kReaders; ++r) {
+        readers.emplace_back([&]() {
+            std::uint64_t last = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                Config c = lock->load();
+                if (!isConsistent(c) || c.version < last) ok.store(false);
+                last = c.version;
+            }
+        });
+    }
+
+    for (std::uint64_t v = 1; v <= kUpdates; ++v) {
+        lock->store(makeConfig(v));
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& t : readers) t.join();
+
+    EXPECT_TRUE(ok.load());
+    EXPECT_EQ(lock->load().version, kUpdates);
+
+    lock->~ConfigLock();
+}
+
+// 5) 双缓冲版本：大对象并发读写
+TEST_F(ShmSeqlockFixture, DoubleBuffered_ConcurrentReadersAndWriter) {
+    auto* lock = createInShm<TableLock>();
+    constexpr std::uint64_t kUpdates = 5000;
+    constexpr int kReaders = 4;
+
+    std::atomic<bool> done{false};
+    std::atomic<bool> ok{true};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < kReaders; ++r) {
+        readers.emplace_back([&]() {
+            BigTable t;
+            std::uint64_t last = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                lock->load(t);
+                if (!isConsistent(t) || t.version < last) ok.store(false);
+                last = t.version;
+            }
+        });
+    }
+
+    BigTable next{};
+    for (std::uint64_t v = 1; v <= kUpdates; ++v) {
+        next.version = v;
+        for (auto& r : next.rows) r = v;
+        lock->store(next);
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& t : readers) t.join();
+
+    EXPECT_TRUE(ok.load());
+    EXPECT_EQ(lock->load().version, kUpdates);
+    EXPECT_EQ(lock->getSequence(), 2 * kUpdates);
+
+    lock->~TableLock();
+}
+
+// 6) 跨进程：子进程读，父进程写
+TEST_F(ShmSeqlockFixture, MultiProcess_ReaderInChild) {
+    auto* lock = createInShm<ConfigLock>(makeConfig(0));
+    constexpr std::uint64_t kUpdates = 50000;
+
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+    if (pid == 0) {
+        bool ok = true;
+        std::uint64_t last = 0;
+        while (last < kUpdates) {
+            Config c = lock->load();
+            ok = ok && isConsistent(c) && c.version >= last;
+            last = c.version;
+        }
+        _exit(ok ? 0 : 1);
+    }
+
+    for (std::uint64_t v = 1; v <= kUpdates; ++v) {
+        lock->store(makeConfig(v));
+    }
+
+    int st = 0;
+    ASSERT_EQ(waitpid(pid, &st, 0), pid);
+    EXPECT_TRUE(WIFEXITED(st) && WEXITSTATUS(st) == 0);
+
+    lock->~ConfigLock();
+}
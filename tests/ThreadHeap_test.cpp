@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+#include <sys/wait.h>   /* For waitpid */
+#include <unistd.h>     /* For fork, _exit */
+
+#include "fixtures/ThreadHeapTestFixture.hpp"
+#include "gc_malloc/CentralHeap/CentralHeap.hpp"
+#include "gc_malloc/ThreadHeap/ProcessAllocatorContext.hpp"
+#include "gc_malloc/ThreadHeap/SizeClassConfig.hpp"
+#include "gc_malloc/ThreadHeap/SizeClassPoolManager.hpp"
+#include "gc_malloc/ThreadHeap/ThreadHeap.hpp"
+
+// 线程退出时 ThreadHeap 的内存归还：空子池直接交还 CentralHeap，仍有在用块的子池进入孤儿链表，
+// 由之后任意线程的 garbageCollect 在块被释放后交还。
+//
+// CentralHeap 的空闲 chunk 链表是后进先出的：从链表头领取几个 chunk 再按原顺序放回，
+// 就能看到最近交还的是哪些 chunk。
+
+namespace {
+
+constexpr std::size_t kBlockBytes = 256u * 1024u;
+
+std::uintptr_t chunkOf(const void* p) {
+    const auto mask = static_cast<std::uintptr_t>(SizeClassConfig::kChunkSizeBytes) - 1;
+    return reinterpret_cast<std::uintptr_t>(p) & ~mask;
+}
+
+// 一个 size class 退出时最多交还的子池数（见 SizeClassPoolManager 的水位）
+constexpr std::size_t kRecentChunks = SizeClassPoolManager::kHighEmptyWatermark;
+
+// p 所在的 chunk 是否在最近交还给 CentralHeap 的 kRecentChunks 个 chunk 之中
+bool recentlyReturned(const void* p) {
+    CentralHeap* central = ProcessAllocatorContext::getCentralHeap();
+    void* taken[kRecentChunks] = {};
+    bool found = false;
+    for (std::size_t i = 0; i < kRecentChunks; ++i) {
+        taken[i] = central->acquireChunk(SizeClassConfig::kChunkSizeBytes);
+        found = found || reinterpret_cast<std::uintptr_t>(taken[i]) == chunkOf(p);
+    }
+    for (std::size_t i = kRecentChunks; i > 0; --i) {
+        central->releaseChunk(taken[i - 1], SizeClassConfig::kChunkSizeBytes);
+    }
+    return found;
+}
+
+// 在新线程中分配一个块；keep 为 false 时线程退出前释放它。返回块地址（释放后只用于定位 chunk）
+void* allocateInExitingThread(bool keep) {
+    void* p = nullptr;
+    std::thread t([&] {
+        p = ThreadHeap::allocate(kBlockBytes);
+        if (p && !keep) {
+            ThreadHeap::deallocate(p);
+        }
+    });
+    t.join();
+    return p;
+}
+
+} // namespace
+
+class ThreadHeapTest : public ThreadHeapTestFixture {};
+
+// 1) 线程退出前释放了全部块：子池在线程析构时就交还 CentralHeap
+TEST_F(ThreadHeapTest, ThreadExit_ReturnsEmptyPools) {
+    void* p = allocateInExitingThread(false);
+    ASSERT_NE(p, nullptr);
+
+    EXPECT_TRUE(recentlyReturned(p));
+}
+
+// 2) 线程带着在用块退出：块保持有效，别的线程释放后由 garbageCollect 交还所在 chunk
+TEST_F(ThreadHeapTest, ThreadExitWithLiveBlock_ChunkReturnedAfterRemoteFree) {
+    void* live = allocateInExitingThread(true);
+    ASSERT_NE(live, nullptr);
+    std::memset(live, 0x5a, kBlockBytes);
+
+    // 块仍在用：所在 chunk 不能交还
+    EXPECT_EQ(ThreadHeap::garbageCollect(), 0u);
+    EXPECT_FALSE(recentlyReturned(live));
+    EXPECT_EQ(static_cast<unsigned char*>(live)[kBlockBytes - 1], 0x5a);
+
+    ThreadHeap::deallocate(live);
+    EXPECT_EQ(ThreadHeap::garbageCollect(), 1u);
+    EXPECT_TRUE(recentlyReturned(live));
+}
+
+// 3) fork 出的子进程丢弃继承来的孤儿链表：其中的块归父进程回收
+TEST_F(ThreadHeapTest, ForkChild_DropsInheritedOrphans) {
+    void* live = allocateInExitingThread(true);
+    ASSERT_NE(live, nullptr);
+    ASSERT_EQ(ThreadHeap::garbageCollect(), 0u);
+
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1) << "fork() failed";
+    if (pid == 0) {
+        // 释放只标记共享内存中的块头；子进程不能替父进程回收
+        ThreadHeap::deallocate(live);
+        _exit(ThreadHeap::garbageCollect() == 0 ? 0 : 1);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+
+    // 子进程标记的释放对父进程可见，由父进程的孤儿链表回收
+    EXPECT_EQ(ThreadHeap::garbageCollect(), 1u);
+    EXPECT_TRUE(recentlyReturned(live));
+}
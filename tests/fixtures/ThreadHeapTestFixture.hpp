@@ -1,35 +1,61 @@
 #pragma once
 #include <gtest/gtest.h>
+#include <iostream>
 
 // 你的工程已有的头
 #include "ShmTestFixture.hpp"
 #include "gc_malloc/ThreadHeap/ProcessAllocatorContext.hpp"
 #include "gc_malloc/CentralHeap/CentralHeap.hpp"
+#include "gc_malloc/ThreadHeap/ThreadHeap.hpp"
 
 /**
  * @brief 统一的分配器测试夹具
- * - 继承 SharedMemoryTestFixture（提供 base/kRegionBytes）
- * - 在 SetUp() 里完成 ProcessAllocatorContext::Setup(...)
- * - 如有需要，可在 TearDown() 做收尾
+ * - 整个测试进程只建立一次分配器区域，并完成 ProcessAllocatorContext::Setup(...)
+ * - 各测试套件共用这块区域，不在套件之间重新映射
+ *
+ * ProcessAllocatorContext 与线程本地的 ThreadHeap 缓存都是进程级的：
+ * 套件之间重新映射区域会让它们指向已经失效的旧映射。
+ * 区域独立于 SharedMemoryTestFixture::segment（那一块由各套件自行重建），
+ * 映射后立即 unlink：fork 出的子进程继承映射，进程退出时自动回收。
+ *
+ * 区域由同一进程内的所有测试共用，测试应归还自己分配的对象。
  *
  * 用法：
  *   #include "tests/fixtures/ThreadHeapTestFixture.hpp"
  *   class MyFixture : public ThreadHeapTestFixture {};
  *   TEST_F(MyFixture, Case) { ... }
  */
-class ThreadHeapTestFixture : public SharedMemoryTestFixture {
+class ThreadHeapTestFixture : public ::testing::Test {
+public:
+    static constexpr const char* kShmName = "/lf_ipc_heap_test";
+    static constexpr std::size_t kRegionBytes = 256u << 20;
+
 protected:
-    static void SetUpTestSuite(){
-        SharedMemoryTestFixture::SetUpTestSuite();
-        // 必须在任何线程/分配发生前初始化分配器上下文
-        ProcessAllocatorContext::Setup(base, kRegionBytes);
-        std::cout << "ProcessAllocatorContext has been set up." << std::endl;
+    void TearDown() override {
+        // 分配器只在 garbageCollect 时回收已释放的块：不回收的话，同一进程里的测试会逐个耗尽区域
+        ThreadHeap::garbageCollect();
+    }
+
+    static void SetUpTestSuite() {
+        // 必须在任何线程/分配发生前初始化分配器上下文；函数内静态量保证每个进程只做一次
+        static void* const base = setUpRegion_();
+        ASSERT_NE(base, nullptr);
     }
 
-    static void TearDownTestSuite() {
-        // 如果你的分配器需要显式收尾（比如 Shutdown/Finalize），在这里调用：
-        // ProcessAllocatorContext::Shutdown();
-        std::cout << "ProcessAllocatorContext is about to be shut down." << std::endl;
-        SharedMemoryTestFixture::TearDownTestSuite();
+private:
+    static void* setUpRegion_() {
+        ShmSegment::unlink(kShmName);
+        try {
+            // 与进程同寿命，故意不析构
+            auto* segment = new ShmSegment(kShmName, kRegionBytes);
+            ShmSegment::unlink(kShmName);
+            void* base = segment->getBaseAddress();
+            ProcessAllocatorContext::Setup(base, kRegionBytes);
+            std::cout << "ProcessAllocatorContext has been set up at " << base << "." << std::endl;
+            return base;
+        } catch (const std::exception& e) {
+            std::cerr << "Exception: " << e.what() << std::endl;
+            return nullptr;
+        }
     }
 };